@@ -1,5 +1,5 @@
-#include "ColorWheel.h"
-
-Studio::Softer::Controls::ColorWheel::ColorWheel()
-{
+#include "ColorWheel.h"
+
+Studio::Softer::Controls::ColorWheel::ColorWheel()
+{
 }
\ No newline at end of file
@@ -1,22 +1,22 @@
-#ifndef __COLORWHEEL__H_
-#define __COLORWHEEL__H_
-
-#include "studiosoftercontrols_global.h"
-
-namespace Studio
-{
-	namespace Softer
-	{
-		namespace Controls
-		{
-			class STUDIOSOFTERCONTROLS_EXPORT ColorWheel
-			{
-			public:
-				ColorWheel();
-			};
-		}
-	}
-}
-
-
+#ifndef __COLORWHEEL__H_
+#define __COLORWHEEL__H_
+
+#include "studiosoftercontrols_global.h"
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Controls
+		{
+			class STUDIOSOFTERCONTROLS_EXPORT ColorWheel
+			{
+			public:
+				ColorWheel();
+			};
+		}
+	}
+}
+
+
 #endif
\ No newline at end of file
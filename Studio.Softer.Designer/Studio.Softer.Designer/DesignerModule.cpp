@@ -0,0 +1,13 @@
+#include "Designer.h"
+#include "ProductModule.h"
+
+
+/**
+* \brief Allows Studio.Softer to create the content of the main window, see ProductRegistry.
+* \param parent The parent widget, the content host of the window.
+* \return The designer.
+*/
+extern "C" Q_DECL_EXPORT QWidget *createProductContent(QWidget *parent)
+{
+	return new Studio::Softer::Products::Designer(parent);
+}
\ No newline at end of file
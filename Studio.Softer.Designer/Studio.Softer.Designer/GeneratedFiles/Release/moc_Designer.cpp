@@ -20,25 +20,25 @@
 QT_BEGIN_MOC_NAMESPACE
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_DEPRECATED
-struct qt_meta_stringdata_Studio__Softer__Windows__Designer_t {
+struct qt_meta_stringdata_Studio__Softer__Products__Designer_t {
     QByteArrayData data[1];
     char stringdata0[34];
 };
 #define QT_MOC_LITERAL(idx, ofs, len) \
     Q_STATIC_BYTE_ARRAY_DATA_HEADER_INITIALIZER_WITH_OFFSET(len, \
-    qptrdiff(offsetof(qt_meta_stringdata_Studio__Softer__Windows__Designer_t, stringdata0) + ofs \
+    qptrdiff(offsetof(qt_meta_stringdata_Studio__Softer__Products__Designer_t, stringdata0) + ofs \
         - idx * sizeof(QByteArrayData)) \
     )
-static const qt_meta_stringdata_Studio__Softer__Windows__Designer_t qt_meta_stringdata_Studio__Softer__Windows__Designer = {
+static const qt_meta_stringdata_Studio__Softer__Products__Designer_t qt_meta_stringdata_Studio__Softer__Products__Designer = {
     {
 QT_MOC_LITERAL(0, 0, 33) // "Studio::Softer::Windows::Desi..."
 
     },
-    "Studio::Softer::Windows::Designer"
+    "Studio::Softer::Products::Designer"
 };
 #undef QT_MOC_LITERAL
 
-static const uint qt_meta_data_Studio__Softer__Windows__Designer[] = {
+static const uint qt_meta_data_Studio__Softer__Products__Designer[] = {
 
  // content:
        7,       // revision
@@ -54,7 +54,7 @@ static const uint qt_meta_data_Studio__Softer__Windows__Designer[] = {
        0        // eod
 };
 
-void Studio::Softer::Windows::Designer::qt_static_metacall(QObject *_o, QMetaObject::Call _c, int _id, void **_a)
+void Studio::Softer::Products::Designer::qt_static_metacall(QObject *_o, QMetaObject::Call _c, int _id, void **_a)
 {
     Q_UNUSED(_o);
     Q_UNUSED(_id);
@@ -62,26 +62,26 @@ void Studio::Softer::Windows::Designer::qt_static_metacall(QObject *_o, QMetaObj
     Q_UNUSED(_a);
 }
 
-const QMetaObject Studio::Softer::Windows::Designer::staticMetaObject = {
-    { &QMainWindow::staticMetaObject, qt_meta_stringdata_Studio__Softer__Windows__Designer.data,
-      qt_meta_data_Studio__Softer__Windows__Designer,  qt_static_metacall, nullptr, nullptr}
+const QMetaObject Studio::Softer::Products::Designer::staticMetaObject = {
+    { &QMainWindow::staticMetaObject, qt_meta_stringdata_Studio__Softer__Products__Designer.data,
+      qt_meta_data_Studio__Softer__Products__Designer,  qt_static_metacall, nullptr, nullptr}
 };
 
 
-const QMetaObject *Studio::Softer::Windows::Designer::metaObject() const
+const QMetaObject *Studio::Softer::Products::Designer::metaObject() const
 {
     return QObject::d_ptr->metaObject ? QObject::d_ptr->dynamicMetaObject() : &staticMetaObject;
 }
 
-void *Studio::Softer::Windows::Designer::qt_metacast(const char *_clname)
+void *Studio::Softer::Products::Designer::qt_metacast(const char *_clname)
 {
     if (!_clname) return nullptr;
-    if (!strcmp(_clname, qt_meta_stringdata_Studio__Softer__Windows__Designer.stringdata0))
+    if (!strcmp(_clname, qt_meta_stringdata_Studio__Softer__Products__Designer.stringdata0))
         return static_cast<void*>(this);
     return QMainWindow::qt_metacast(_clname);
 }
 
-int Studio::Softer::Windows::Designer::qt_metacall(QMetaObject::Call _c, int _id, void **_a)
+int Studio::Softer::Products::Designer::qt_metacall(QMetaObject::Call _c, int _id, void **_a)
 {
     _id = QMainWindow::qt_metacall(_c, _id, _a);
     return _id;
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QtCore/qglobal.h>
+
+#ifndef BUILD_STATIC
+# if defined(STUDIOSOFTERDESIGNER_LIB)
+#  define STUDIOSOFTERDESIGNER_EXPORT Q_DECL_EXPORT
+# else
+#  define STUDIOSOFTERDESIGNER_EXPORT Q_DECL_IMPORT
+# endif
+#else
+# define STUDIOSOFTERDESIGNER_EXPORT
+#endif
@@ -0,0 +1,355 @@
+#include "StyleSheet.h"
+#include "ThemeTokens.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QRegularExpression>
+#include <QDirIterator>
+#include <QTextStream>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSet>
+
+using namespace Studio::Softer::Windows;
+
+namespace {
+	//The objectNames given to the widgets, by setObjectName() in the sources and by the name of the .ui widgets.
+	auto scan_object_names(const QStringList& directories) -> QSet<QString> {
+		const QRegularExpression code("setObjectName\\(\\s*(?:QStringLiteral\\(|QLatin1String\\(|QString\\()?\\s*\"([^\"]+)\"");
+		const QRegularExpression form("<widget\\s[^>]*name=\"([^\"]+)\"");
+
+		QSet<QString> names;
+		for (const auto &directory : directories)
+		{
+			QDirIterator files(directory, QStringList() << "*.cpp" << "*.h" << "*.ui", QDir::Files, QDirIterator::Subdirectories);
+			while (files.hasNext())
+			{
+				QFile file(files.next());
+				if (!file.open(QFile::ReadOnly)) continue;
+				auto content = QString::fromUtf8(file.readAll());
+				auto matches = (file.fileName().endsWith(".ui") ? form : code).globalMatch(content);
+				while (matches.hasNext())
+					names.insert(matches.next().captured(1));
+			}
+		}
+		return names;
+	}
+
+	//The line of the first use of an objectName in the source, for the error messages.
+	auto line_of(const QString& source, const QString& objectName) -> int {
+		auto match = QRegularExpression("#" + QRegularExpression::escape(objectName) + "(?![\\w-])").match(source);
+		return match.hasMatch() ? source.left(match.capturedStart()).count(QLatin1Char('\n')) + 1 : 1;
+	}
+
+	//Splits the subject of a selector into its sub-control and pseudo-state, ie: "QMenuBar::item:selected" gives ("item", "selected").
+	auto split_states(const QString& selector, QString& subControl, QString& pseudoState) -> void {
+		auto compounds = selector.split(QRegularExpression("[\\s>]+"), QString::SkipEmptyParts);
+		auto subject = compounds.isEmpty() ? QString() : compounds.last();
+		subject.remove(QRegularExpression("\\[[^\\]]*\\]"));
+
+		subControl.clear();
+		pseudoState.clear();
+		auto colon = subject.indexOf(QLatin1Char(':'));
+		if (colon < 0) return;
+
+		auto states = subject.mid(colon);
+		if (states.startsWith("::"))
+		{
+			auto end = states.indexOf(QLatin1Char(':'), 2);
+			subControl = states.mid(2, end < 0 ? -1 : end - 2);
+			states = end < 0 ? QString() : states.mid(end);
+		}
+		pseudoState = states.mid(1);
+	}
+
+	//A C++ string literal, the non ASCII characters are written as octal escapes of their UTF-8 bytes.
+	auto literal(const QString& text) -> QString {
+		QString result("\"");
+		for (auto byte : text.toUtf8())
+		{
+			auto c = static_cast<unsigned char>(byte);
+			if (c == '\\' || c == '"' || c == '?') result += QString("\\%1").arg(QLatin1Char(byte));
+			else if (c < 0x20 || c >= 0x7f) result += QString("\\%1").arg(c, 3, 8, QLatin1Char('0'));
+			else result += QLatin1Char(byte);
+		}
+		return result + QLatin1Char('"');
+	}
+
+	//The subject of a rule as given to --native, its objectName or else its class.
+	auto subject_of(const StyleRule& rule) -> QString {
+		return rule.objectName.isEmpty() ? rule.className : rule.objectName;
+	}
+
+	//The index of a token of the theme, ie: "@caption.hover", or -1 for a literal.
+	auto token_index(const QString& value) -> int {
+		if (!value.startsWith(QLatin1Char('@'))) return -1;
+		for (auto i = 0; i < ThemeTokens::count; ++i)
+		{
+			if (value.mid(1) == QLatin1String(ThemeTokens::names[i]))
+				return i;
+		}
+		return -1;
+	}
+
+	//The properties whose value is a length, the others of a native rule are colours.
+	auto is_length(const QString& property) -> bool {
+		static const QRegularExpression length("width|height|spacing|padding|margin|radius");
+		return length.match(property).hasMatch();
+	}
+
+	//A literal colour, ie: "#202020", "#fff" or "transparent".
+	auto parse_color(const QString& value, quint32& argb) -> bool {
+		static const QRegularExpression color("^#([0-9a-fA-F]{6}|[0-9a-fA-F]{3})$");
+		if (value == "transparent") { argb = 0x00000000u; return true; }
+		if (value == "white") { argb = 0xffffffffu; return true; }
+		if (value == "black") { argb = 0xff000000u; return true; }
+
+		auto match = color.match(value);
+		if (!match.hasMatch()) return false;
+		auto hex = match.captured(1);
+		if (hex.size() == 3)
+			hex = QString(hex[0]) + hex[0] + hex[1] + hex[1] + hex[2] + hex[2];
+		argb = 0xff000000u | hex.toUInt(Q_NULLPTR, 16);
+		return true;
+	}
+
+	//A literal length in pixels, ie: "1px" or "0".
+	auto parse_length(const QString& value, int& pixels) -> bool {
+		static const QRegularExpression length("^(\\d+)(?:px)?$");
+		auto match = length.match(value);
+		if (!match.hasMatch()) return false;
+		pixels = match.captured(1).toInt();
+		return true;
+	}
+
+	//A typed entry of a declaration of a native rule, empty when its value is neither a token nor a literal of its type.
+	auto typed_entry(const StyleRule& rule, const QString& pseudoState, const StyleDeclaration& declaration, bool& metric) -> QString {
+		auto prefix = QString("{ %1, %2, %3, %4, ").arg(literal(rule.objectName), literal(rule.className), literal(pseudoState), literal(declaration.first));
+		auto token = token_index(declaration.second);
+		metric = is_length(declaration.first);
+		if (token >= 0)
+			return prefix + QString("%1, 0 }").arg(token);
+
+		quint32 argb = 0;
+		int pixels = 0;
+		if (!metric && parse_color(declaration.second, argb))
+			return prefix + QString("-1, 0x%1u }").arg(argb, 8, 16, QLatin1Char('0'));
+		if (metric && parse_length(declaration.second, pixels))
+			return prefix + QString("-1, %1 }").arg(pixels);
+		return QString();
+	}
+
+	//A table of the generated header, or a null pointer when it is empty since C++ has no zero-sized arrays.
+	auto write_table(QTextStream& out, const char *type, const char *name, const QStringList& entries) -> void {
+		if (entries.isEmpty())
+		{
+			out << "\t\t\t\tconstexpr const Windows::StyleTables::" << type << " *" << name << " = nullptr;\n";
+			out << "\t\t\t\tconstexpr int " << name << "Count = 0;\n\n";
+			return;
+		}
+		out << "\t\t\t\tconstexpr Windows::StyleTables::" << type << ' ' << name << "[] = {\n";
+		for (const auto &entry : entries)
+			out << "\t\t\t\t\t" << entry << ",\n";
+		out << "\t\t\t\t};\n";
+		out << "\t\t\t\tconstexpr int " << name << "Count = " << entries.size() << ";\n\n";
+	}
+
+	auto generate(const QString& name, const QString& fileName, const QByteArray& source, const StyleSheet& styleSheet, const QSet<QString>& natives) -> QByteArray {
+		QStringList rules, declarations, colors, metrics, text;
+		for (const auto &rule : styleSheet.rules())
+		{
+			QString subControl, pseudoState;
+			split_states(rule.selector, subControl, pseudoState);
+
+			//The native rules are only typed values, they are neither in the rules nor in the text of Qt.
+			if (natives.contains(subject_of(rule)))
+			{
+				for (const auto &declaration : rule.declarations)
+				{
+					auto metric = false;
+					auto entry = typed_entry(rule, pseudoState, declaration, metric);
+					(metric ? metrics : colors).append(entry);
+				}
+				continue;
+			}
+
+			rules.append(QString("{ %1, %2, %3, %4, %5, %6, %7 }")
+				.arg(literal(rule.selector), literal(rule.objectName), literal(rule.className), literal(subControl), literal(pseudoState))
+				.arg(declarations.size()).arg(rule.declarations.size()));
+
+			QString ruleText = rule.selector + QLatin1Char('{');
+			for (const auto &declaration : rule.declarations)
+			{
+				declarations.append(QString("{ %1, %2 }").arg(literal(declaration.first), literal(declaration.second)));
+				ruleText += declaration.first + QLatin1Char(':') + declaration.second + QLatin1Char(';');
+			}
+			text.append(literal(ruleText + QLatin1Char('}')));
+		}
+
+		QByteArray header;
+		QTextStream out(&header);
+		auto guard = QString("__%1_QSS__H_").arg(name.toUpper());
+		out << "// Generated by Studio.Softer.QssCompiler from " << fileName << ", do not edit.\n";
+		out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+		out << "#include \"StyleTables.h\"\n\n";
+		out << "namespace Studio\n{\n\tnamespace Softer\n\t{\n\t\tnamespace Styles\n\t\t{\n";
+		out << "\t\t\tnamespace " << name << "\n\t\t\t{\n";
+		write_table(out, "Rule", "rules", rules);
+		write_table(out, "Declaration", "declarations", declarations);
+		write_table(out, "Color", "colors", colors);
+		write_table(out, "Metric", "metrics", metrics);
+
+		//The text is split by rule, under the limit of the length of a string literal.
+		out << "\t\t\t\tconstexpr char text[] =\n";
+		for (const auto &rule : text)
+			out << "\t\t\t\t\t" << rule << "\n";
+		if (text.isEmpty()) out << "\t\t\t\t\t\"\"\n";
+		out << "\t\t\t\t\t;\n\n";
+
+		out << "\t\t\t\tconstexpr Windows::StyleTables::Table table = {\n";
+		out << "\t\t\t\t\t" << literal(fileName) << ", \"" << StyleSheet::hashOf(source).toHex() << "\", text,\n";
+		out << "\t\t\t\t\trules, rulesCount, declarations, declarationsCount,\n";
+		out << "\t\t\t\t\tcolors, colorsCount, metrics, metricsCount\n";
+		out << "\t\t\t\t};\n";
+		out << "\t\t\t}\n\t\t}\n\t}\n}\n\n#endif\n";
+		out.flush();
+		return header;
+	}
+}
+
+/**
+* Compiles a .qss file into a header of constexpr tables, ie:
+* Studio.Softer.QssCompiler Style.qss GeneratedFiles/Style_qss.h --sources ../../Studio.Softer.Windows --allow tabsMenuButton --native windowTitleBar
+* The variables that are tokens of the themes are kept in the tables, the current theme gives their values.
+* The rules of a --native objectName or class are painted by the widgets themselves, they are only
+* written as typed colours and metrics.
+* The build fails when a selector uses an objectName that no widget of the sources has, or a variable
+* that is neither defined by the stylesheet nor a token, or when a native rule cannot be typed.
+*/
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("Studio.Softer.QssCompiler");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Compiles a stylesheet into constexpr style tables.");
+	parser.addHelpOption();
+	parser.addPositionalArgument("input", "The .qss file.");
+	parser.addPositionalArgument("output", "The header to write.");
+	QCommandLineOption nameOption("name", "The namespace of the tables, the name of the input by default.", "name");
+	QCommandLineOption sourcesOption("sources", "A directory of sources and .ui files giving the known objectNames.", "directory");
+	QCommandLineOption allowOption("allow", "An objectName given outside of the sources, ie: by a third party library.", "objectName");
+	QCommandLineOption nativeOption("native", "An objectName or a class painted from the typed tables, its rules are not given to Qt.", "subject");
+	parser.addOption(nameOption);
+	parser.addOption(sourcesOption);
+	parser.addOption(allowOption);
+	parser.addOption(nativeOption);
+	parser.process(app);
+
+	QTextStream errors(stderr);
+	auto arguments = parser.positionalArguments();
+	if (arguments.size() != 2)
+	{
+		errors << "usage: Studio.Softer.QssCompiler <input.qss> <output.h> [--name <name>] [--sources <directory>]... [--allow <objectName>]... [--native <subject>]...\n";
+		return 2;
+	}
+
+	QFile input(arguments[0]);
+	if (!input.open(QFile::ReadOnly))
+	{
+		errors << arguments[0] << ": error: cannot read the stylesheet\n";
+		return 2;
+	}
+	auto source = input.readAll();
+	auto styleSheet = StyleSheet::compile(source);
+	auto name = parser.isSet(nameOption) ? parser.value(nameOption) : QFileInfo(arguments[0]).completeBaseName();
+	name.replace(QRegularExpression("[^A-Za-z0-9_]"), "_");
+
+	//Validates the variables and the objectNames before writing anything, a stale header would hide the error.
+	auto text = QString::fromUtf8(source);
+	auto path = QDir::toNativeSeparators(QFileInfo(arguments[0]).absoluteFilePath());
+	QSet<QString> tokens;
+	for (const auto &token : ThemeTokens::names)
+		tokens.insert(QString::fromLatin1(token));
+
+	QRegularExpression reference("@([A-Za-z_][\\w.-]*)");
+	auto failed = false;
+	for (const auto &rule : styleSheet.rules())
+	{
+		for (const auto &declaration : rule.declarations)
+		{
+			for (auto match = reference.globalMatch(declaration.second); match.hasNext();)
+			{
+				auto variable = match.next().captured(1);
+				if (tokens.contains(variable)) continue;
+				errors << path << ": error: undefined variable '@" << variable
+					<< "' in '" << rule.selector << " { " << declaration.first << ": " << declaration.second << " }'\n";
+				failed = true;
+			}
+		}
+	}
+
+	if (parser.isSet(sourcesOption))
+	{
+		auto known = scan_object_names(parser.values(sourcesOption));
+		for (const auto &allowed : parser.values(allowOption))
+			known.insert(allowed);
+
+		for (const auto &rule : styleSheet.rules())
+		{
+			if (rule.objectName.isEmpty() || known.contains(rule.objectName)) continue;
+			errors << path << '(' << line_of(text, rule.objectName) << "): error: unknown selector '" << rule.selector
+				<< "', no widget has the objectName '" << rule.objectName << "'\n";
+			failed = true;
+		}
+	}
+	//A native rule is read by its subject and pseudo-state only, each value is a token or a literal of its type.
+	auto natives = parser.values(nativeOption).toSet();
+	QSet<QString> nativeSubjects;
+	for (const auto &rule : styleSheet.rules())
+	{
+		auto subject = subject_of(rule);
+		if (!natives.contains(subject)) continue;
+		nativeSubjects.insert(subject);
+
+		QString subControl, pseudoState;
+		split_states(rule.selector, subControl, pseudoState);
+		if (!subControl.isEmpty() || rule.selector.contains(QRegularExpression("[\\s>\\[]")))
+		{
+			errors << path << '(' << line_of(text, subject) << "): error: native selector '" << rule.selector
+				<< "' has a sub-control, an ancestor or an attribute\n";
+			failed = true;
+		}
+		for (const auto &declaration : rule.declarations)
+		{
+			auto metric = false;
+			if (!typed_entry(rule, pseudoState, declaration, metric).isEmpty()) continue;
+			errors << path << ": error: native declaration '" << rule.selector << " { " << declaration.first << ": " << declaration.second
+				<< " }' is neither a token nor a " << (metric ? "length" : "colour") << '\n';
+			failed = true;
+		}
+	}
+	for (const auto &subject : natives - nativeSubjects)
+	{
+		errors << path << ": error: no rule of the native subject '" << subject << "'\n";
+		failed = true;
+	}
+	if (failed) return 1;
+
+	auto header = generate(name, QFileInfo(arguments[0]).fileName(), source, styleSheet, natives);
+
+	//Unchanged tables keep their timestamp, the sources including them are not built again.
+	QFile previous(arguments[1]);
+	if (previous.open(QFile::ReadOnly) && previous.readAll() == header)
+		return 0;
+	previous.close();
+
+	QDir().mkpath(QFileInfo(arguments[1]).absolutePath());
+	QSaveFile output(arguments[1]);
+	if (!output.open(QIODevice::WriteOnly) || output.write(header) != header.size() || !output.commit())
+	{
+		errors << arguments[1] << ": error: cannot write the tables\n";
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include "BenchmarkReport.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSaveFile>
+#include <QtTest>
+#include <algorithm>
+
+namespace {
+	const char jsonSwitch[] = "--json=";
+
+	auto milliseconds(qint64 nanoseconds) -> double {
+		return static_cast<double>(nanoseconds) / 1e6;
+	}
+}
+
+
+/**
+* \brief Allows to get the report of the test process.
+* \return The report.
+*/
+Studio::Softer::Tests::BenchmarkReport& Studio::Softer::Tests::BenchmarkReport::instance()
+{
+	static BenchmarkReport report;
+	return report;
+}
+
+
+/**
+* \brief Allows to record the duration of one iteration of a benchmark.
+* \param name The name of the benchmark, ie: "Window.Construct".
+* \param nanoseconds The duration of the iteration.
+*/
+void Studio::Softer::Tests::BenchmarkReport::addSample(const QString& name, qint64 nanoseconds)
+{
+	m_samples[name].append(nanoseconds);
+}
+
+
+/**
+* \brief Allows to record a value measured by a test, ie: the number of widgets touched by a reload.
+* \param name The name of the value.
+* \param value The value.
+*/
+void Studio::Softer::Tests::BenchmarkReport::setValue(const QString& name, const QVariant& value)
+{
+	m_values.insert(name, value);
+}
+
+
+/**
+* \brief Allows to write the minimum, the median and the number of iterations of each benchmark, in milliseconds.
+* \param path The path of the JSON file.
+* \return True when the file was written.
+*/
+bool Studio::Softer::Tests::BenchmarkReport::write(const QString& path) const
+{
+	QJsonObject benchmarks;
+	for (auto it = m_samples.cbegin(); it != m_samples.cend(); ++it)
+	{
+		auto samples = it.value();
+		std::sort(samples.begin(), samples.end());
+
+		QJsonObject benchmark;
+		benchmark.insert("iterations", samples.size());
+		benchmark.insert("minMs", milliseconds(samples.first()));
+		benchmark.insert("medianMs", milliseconds(samples.at(samples.size() / 2)));
+		benchmarks.insert(it.key(), benchmark);
+	}
+
+	QJsonObject root;
+	root.insert("test", QCoreApplication::applicationName());
+	root.insert("platform", QGuiApplication::platformName());
+	root.insert("qt", QString::fromLatin1(qVersion()));
+	root.insert("benchmarks", benchmarks);
+	root.insert("values", QJsonObject::fromVariantMap(m_values));
+
+	QSaveFile file(path);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	file.write(QJsonDocument(root).toJson());
+	return file.commit();
+}
+
+
+/**
+* \brief Allows to time an iteration of a benchmark from now.
+* \param name The name of the benchmark.
+*/
+Studio::Softer::Tests::BenchmarkSample::BenchmarkSample(const QString& name) :
+	m_name(name), m_stopped(false)
+{
+	m_timer.start();
+}
+
+
+Studio::Softer::Tests::BenchmarkSample::~BenchmarkSample()
+{
+	stop();
+}
+
+
+/**
+* \brief Allows to end the iteration before the end of the scope, ie: before the destruction of a window.
+*/
+void Studio::Softer::Tests::BenchmarkSample::stop()
+{
+	if (m_stopped) return;
+	m_stopped = true;
+	BenchmarkReport::instance().addSample(m_name, m_timer.nsecsElapsed());
+}
+
+
+/**
+* \brief Allows to run a test and to write the JSON report of its benchmarks.
+* The --json=<file> argument is removed before the arguments are given to QTest.
+* \param test The test object.
+* \param argc The integer(argc) of the main function.
+* \param argv The *char[] pointer of the main function.
+* \return The result of QTest::qExec, or 1 when the report cannot be written.
+*/
+int Studio::Softer::Tests::exec(QObject* test, int argc, char* argv[])
+{
+	QString jsonPath;
+	QVector<char *> arguments;
+	for (auto i = 0; i < argc; ++i)
+	{
+		if (i > 0 && qstrncmp(argv[i], jsonSwitch, sizeof(jsonSwitch) - 1) == 0)
+			jsonPath = QString::fromLocal8Bit(argv[i] + sizeof(jsonSwitch) - 1);
+		else
+			arguments.append(argv[i]);
+	}
+
+	auto result = QTest::qExec(test, arguments.size(), arguments.data());
+	if (!jsonPath.isEmpty() && !BenchmarkReport::instance().write(jsonPath))
+	{
+		qWarning("Cannot write the benchmark report %s", qPrintable(jsonPath));
+		return 1;
+	}
+	return result;
+}
\ No newline at end of file
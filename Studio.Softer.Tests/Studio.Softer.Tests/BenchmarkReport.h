@@ -0,0 +1,75 @@
+#ifndef __BENCHMARKREPORT__H_
+#define __BENCHMARKREPORT__H_
+
+#include <QElapsedTimer>
+#include <QApplication>
+#include <QVariantMap>
+#include <QString>
+#include <QVector>
+#include <QMap>
+
+class QObject;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Tests
+		{
+			/**
+			* \brief The results of the benchmarks of a test, written as JSON to track regressions between releases.
+			* QTest only prints its QBENCHMARK results, each iteration is also recorded here by a BenchmarkSample.
+			* The file is requested with --json=<file> on the command line of the test.
+			*/
+			class BenchmarkReport
+			{
+			public:
+				static BenchmarkReport &instance();
+				void addSample(const QString &name, qint64 nanoseconds);
+				void setValue(const QString &name, const QVariant &value);
+				bool write(const QString &path) const;
+
+			private:
+				BenchmarkReport() = default;
+				BenchmarkReport(const BenchmarkReport &) = delete;
+				BenchmarkReport &operator=(const BenchmarkReport &) = delete;
+
+				QMap<QString, QVector<qint64>> m_samples;
+				QVariantMap m_values;
+			};
+
+			/**
+			* \brief Times one iteration of a benchmark, until stop() or the end of the scope.
+			*/
+			class BenchmarkSample
+			{
+			public:
+				explicit BenchmarkSample(const QString &name);
+				~BenchmarkSample();
+				void stop();
+
+			private:
+				Q_DISABLE_COPY(BenchmarkSample)
+				QString m_name;
+				QElapsedTimer m_timer;
+				bool m_stopped;
+			};
+
+			int exec(QObject *test, int argc, char *argv[]);
+		}
+	}
+}
+
+/**
+* \brief The main function of a widget test, as QTEST_MAIN, with the JSON output of its benchmarks.
+*/
+#define STUDIO_SOFTER_TEST_MAIN(TestObject) \
+int main(int argc, char *argv[]) \
+{ \
+	QApplication application(argc, argv); \
+	application.setAttribute(Qt::AA_Use96Dpi, true); \
+	TestObject test; \
+	return Studio::Softer::Tests::exec(&test, argc, argv); \
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "BenchmarkReport.h"
+#include "CaptionButton.h"
+#include "IconCache.h"
+#include "ThemeEngine.h"
+
+#include <QPushButton>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	const QSize buttonSize(45, 30);
+
+	// the icon of the minimize button, read from the sources as the tests do not embed the resources
+	auto icon_path() -> QString {
+		return QString(STUDIO_SOFTER_SOURCE_DIR "/Studio.Softer/Studio.Softer/IconsCommand/Minimize.png");
+	}
+
+	// the mouse enters and leaves the button, each state painted at once as the title bar does on a hover
+	auto hover(QWidget *button) -> void {
+		QEvent enter(QEvent::Enter);
+		button->setAttribute(Qt::WA_UnderMouse, true);
+		QApplication::sendEvent(button, &enter);
+		button->repaint();
+
+		QEvent leave(QEvent::Leave);
+		button->setAttribute(Qt::WA_UnderMouse, false);
+		QApplication::sendEvent(button, &leave);
+		button->repaint();
+	}
+}
+
+/**
+* \brief The states of a caption button and the cost of its hover repaint.
+* The benchmarks compare the cached state pixmaps with a QPushButton styled by a stylesheet.
+*/
+class TestCaptionButton : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void themeColors();
+	void statePixmaps();
+	void setColors();
+	void statePixmapRatio();
+	void hoverCaptionButton();
+	void hoverStyledButton();
+};
+
+void TestCaptionButton::initTestCase()
+{
+	QStandardPaths::setTestModeEnabled(true);
+}
+
+// the colours are the ones of the current theme unless they are given
+void TestCaptionButton::themeColors()
+{
+	Windows::CaptionButton button;
+	QCOMPARE(button.hoverColor(), Windows::ThemeEngine::instance().color(Windows::ThemeEngine::CaptionHover));
+	QCOMPARE(button.pressedColor(), Windows::ThemeEngine::instance().color(Windows::ThemeEngine::CaptionPressed));
+}
+
+// a state is rendered once and shared by the buttons with the same icon, size and colours
+void TestCaptionButton::statePixmaps()
+{
+	Windows::CaptionButton first;
+	Windows::CaptionButton second;
+	first.resize(buttonSize);
+	second.resize(buttonSize);
+
+	auto hover = first.statePixmap(Windows::CaptionButton::Hover);
+	QVERIFY(!hover.isNull());
+	QCOMPARE(second.statePixmap(Windows::CaptionButton::Hover).cacheKey(), hover.cacheKey());
+	QVERIFY(first.statePixmap(Windows::CaptionButton::Pressed).cacheKey() != hover.cacheKey());
+}
+
+void TestCaptionButton::setColors()
+{
+	Windows::CaptionButton button;
+	button.resize(buttonSize);
+	auto hover = button.statePixmap(Windows::CaptionButton::Hover);
+
+	button.setColors(QColor(0xe8, 0x11, 0x23), QColor(0xf1, 0x70, 0x7a));
+	QCOMPARE(button.hoverColor(), QColor(0xe8, 0x11, 0x23));
+	QVERIFY(button.statePixmap(Windows::CaptionButton::Hover).cacheKey() != hover.cacheKey());
+}
+
+// the pictures are rendered in device pixels, run again under QT_SCALE_FACTOR by ctest
+void TestCaptionButton::statePixmapRatio()
+{
+	Windows::CaptionButton button;
+	button.setIconPath(icon_path());
+	button.resize(buttonSize);
+	button.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&button));
+
+	auto ratio = button.windowHandle()->devicePixelRatio();
+	if (qEnvironmentVariableIsSet("QT_SCALE_FACTOR"))
+		QCOMPARE(ratio, qgetenv("QT_SCALE_FACTOR").toDouble());
+
+	auto hover = button.statePixmap(Windows::CaptionButton::Hover);
+	QCOMPARE(hover.devicePixelRatio(), ratio);
+	QCOMPARE(hover.size(), buttonSize * ratio);
+
+	// the icon is drawn from a raster of the same ratio, not scaled from the one of a single pixel ratio
+	auto icon = Windows::IconCache::instance().pixmap(icon_path(), button.iconSize(), ratio);
+	QCOMPARE(icon.devicePixelRatio(), ratio);
+	QCOMPARE(icon.size(), button.iconSize() * ratio);
+	QCOMPARE(button.statePixmap(Windows::CaptionButton::Hover).cacheKey(), hover.cacheKey());
+}
+
+void TestCaptionButton::hoverCaptionButton()
+{
+	Windows::CaptionButton button;
+	button.setIconPath(icon_path());
+	button.resize(buttonSize);
+	button.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&button));
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("CaptionButton.Hover");
+		hover(&button);
+	}
+}
+
+// the baseline, the rules of the caption buttons before CaptionButton: the icon is an image url of the
+// application stylesheet, the hover a background colour, and the button has its own inline stylesheet
+void TestCaptionButton::hoverStyledButton()
+{
+	qApp->setStyleSheet(QString("#minimizeButton { image: url(%1); background-color: transparent; border: none; }"
+		"#minimizeButton:hover { background-color: %2; }"
+		"#minimizeButton:pressed { background-color: %3; }")
+		.arg(icon_path(),
+			Windows::ThemeEngine::instance().color(Windows::ThemeEngine::CaptionHover).name(),
+			Windows::ThemeEngine::instance().color(Windows::ThemeEngine::CaptionPressed).name()));
+
+	QPushButton button;
+	button.setObjectName("minimizeButton");
+	button.setStyleSheet("margin: 0px;");
+	button.resize(buttonSize);
+	button.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&button));
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("CaptionButton.HoverStyledButton");
+		hover(&button);
+	}
+	qApp->setStyleSheet(QString());
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestCaptionButton)
+
+#include "tst_CaptionButton.moc"
\ No newline at end of file
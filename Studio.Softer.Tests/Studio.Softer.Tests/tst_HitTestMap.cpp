@@ -0,0 +1,188 @@
+#include "BenchmarkReport.h"
+#include "HitTestMap.h"
+
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+typedef Windows::HitTestMap::Region Region;
+Q_DECLARE_METATYPE(Region)
+
+namespace {
+	const QSize windowSize(800, 600);
+	const QRect caption(0, 0, 800, 30);
+
+	// the title bar of a window, the menu bar and the three caption buttons are not part of the caption
+	auto exclusions() -> QVector<QRect> {
+		return QVector<QRect>() << QRect(0, 0, 200, 30) << QRect(665, 0, 45, 30) << QRect(710, 0, 45, 30) << QRect(755, 0, 45, 30);
+	}
+
+	auto new_map(qreal devicePixelRatio = 1.0) -> Windows::HitTestMap {
+		Windows::HitTestMap map;
+		map.setBorderWidth(8);
+		map.update(windowSize, caption, exclusions(), devicePixelRatio);
+		return map;
+	}
+}
+
+/**
+* \brief The regions of a frameless window, in device pixels, and the cost of a hit test.
+*/
+class TestHitTestMap : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void hitTest_data();
+	void hitTest();
+	void rightBorder();
+	void exclusionOutsideCaption();
+	void devicePixelRatio_data();
+	void devicePixelRatio();
+	void resizeDisabled();
+	void invalidate();
+	void benchmarkHitTest();
+};
+
+void TestHitTestMap::hitTest_data()
+{
+	QTest::addColumn<QPoint>("position");
+	QTest::addColumn<Region>("region");
+
+	// the corners have the priority over the borders, and the borders over the caption
+	QTest::newRow("top left") << QPoint(0, 0) << Windows::HitTestMap::TopLeft;
+	QTest::newRow("top right") << QPoint(799, 0) << Windows::HitTestMap::TopRight;
+	QTest::newRow("bottom left") << QPoint(0, 599) << Windows::HitTestMap::BottomLeft;
+	QTest::newRow("bottom right") << QPoint(799, 599) << Windows::HitTestMap::BottomRight;
+	QTest::newRow("inner top left") << QPoint(7, 7) << Windows::HitTestMap::TopLeft;
+	QTest::newRow("top") << QPoint(400, 0) << Windows::HitTestMap::Top;
+	QTest::newRow("left") << QPoint(0, 300) << Windows::HitTestMap::Left;
+	QTest::newRow("right") << QPoint(799, 300) << Windows::HitTestMap::Right;
+	QTest::newRow("bottom") << QPoint(400, 599) << Windows::HitTestMap::Bottom;
+	QTest::newRow("border over button") << QPoint(780, 2) << Windows::HitTestMap::Top;
+	QTest::newRow("border over menu bar") << QPoint(100, 2) << Windows::HitTestMap::Top;
+	QTest::newRow("caption") << QPoint(400, 15) << Windows::HitTestMap::Caption;
+	QTest::newRow("menu bar") << QPoint(100, 15) << Windows::HitTestMap::Client;
+	QTest::newRow("close button") << QPoint(780, 15) << Windows::HitTestMap::Client;
+	QTest::newRow("between buttons") << QPoint(709, 15) << Windows::HitTestMap::Client;
+	QTest::newRow("left of buttons") << QPoint(664, 15) << Windows::HitTestMap::Caption;
+	QTest::newRow("below caption") << QPoint(400, 30) << Windows::HitTestMap::Client;
+	QTest::newRow("content") << QPoint(400, 300) << Windows::HitTestMap::Client;
+	QTest::newRow("outside") << QPoint(800, 300) << Windows::HitTestMap::Client;
+	QTest::newRow("negative") << QPoint(-1, 300) << Windows::HitTestMap::Client;
+}
+
+void TestHitTestMap::hitTest()
+{
+	QFETCH(QPoint, position);
+	QFETCH(Region, region);
+
+	auto map = new_map();
+	QVERIFY(map.isValid());
+	QCOMPARE(map.hitTest(position), region);
+}
+
+// the borders are borderWidth pixels wide on both sides, QRect::right() is the last pixel
+void TestHitTestMap::rightBorder()
+{
+	auto map = new_map();
+	const auto right = windowSize.width() - 1;
+	const auto bottom = windowSize.height() - 1;
+
+	QCOMPARE(map.hitTest(QPoint(right - map.borderWidth(), 300)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(QPoint(right - map.borderWidth() + 1, 300)), Windows::HitTestMap::Right);
+	QCOMPARE(map.hitTest(QPoint(map.borderWidth() - 1, 300)), Windows::HitTestMap::Left);
+	QCOMPARE(map.hitTest(QPoint(map.borderWidth(), 300)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(QPoint(400, bottom - map.borderWidth())), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(QPoint(400, bottom - map.borderWidth() + 1)), Windows::HitTestMap::Bottom);
+}
+
+// an exclusion outside of the caption is dropped, the caption does not leak into the content
+void TestHitTestMap::exclusionOutsideCaption()
+{
+	Windows::HitTestMap map;
+	map.update(windowSize, caption, QVector<QRect>() << QRect(300, 100, 50, 50), 1.0);
+
+	QCOMPARE(map.hitTest(QPoint(320, 15)), Windows::HitTestMap::Caption);
+	QCOMPARE(map.hitTest(QPoint(320, 120)), Windows::HitTestMap::Client);
+}
+
+void TestHitTestMap::devicePixelRatio_data()
+{
+	QTest::addColumn<qreal>("devicePixelRatio");
+	QTest::newRow("100%") << 1.0;
+	QTest::newRow("125%") << 1.25;
+	QTest::newRow("150%") << 1.5;
+	QTest::newRow("200%") << 2.0;
+}
+
+// the layout is given in device independent pixels and hit tested in device pixels
+void TestHitTestMap::devicePixelRatio()
+{
+	QFETCH(qreal, devicePixelRatio);
+
+	auto map = new_map(devicePixelRatio);
+	auto device = [devicePixelRatio](int x, int y) { return QPoint(qRound(x * devicePixelRatio), qRound(y * devicePixelRatio)); };
+	const auto right = qRound(windowSize.width() * devicePixelRatio) - 1;
+
+	QCOMPARE(map.hitTest(QPoint(right, 300)), Windows::HitTestMap::Right);
+	QCOMPARE(map.hitTest(QPoint(right + 1, 300)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(device(400, 15)), Windows::HitTestMap::Caption);
+	QCOMPARE(map.hitTest(device(780, 15)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(device(664, 15)), Windows::HitTestMap::Caption);
+	QCOMPARE(map.hitTest(device(400, 31)), Windows::HitTestMap::Client);
+}
+
+// a maximized or fixed size window has no resize border, the caption reaches the edges
+void TestHitTestMap::resizeDisabled()
+{
+	auto map = new_map();
+	map.setResizable(false, false);
+	QCOMPARE(map.hitTest(QPoint(0, 0)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(QPoint(400, 0)), Windows::HitTestMap::Caption);
+	QCOMPARE(map.hitTest(QPoint(0, 300)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(QPoint(799, 599)), Windows::HitTestMap::Client);
+
+	map.setResizable(true, false);
+	QCOMPARE(map.hitTest(QPoint(0, 300)), Windows::HitTestMap::Left);
+	QCOMPARE(map.hitTest(QPoint(0, 0)), Windows::HitTestMap::Left);
+	QCOMPARE(map.hitTest(QPoint(400, 0)), Windows::HitTestMap::Caption);
+
+	map.setResizable(false, true);
+	QCOMPARE(map.hitTest(QPoint(0, 300)), Windows::HitTestMap::Client);
+	QCOMPARE(map.hitTest(QPoint(0, 0)), Windows::HitTestMap::Top);
+}
+
+void TestHitTestMap::invalidate()
+{
+	auto map = new_map();
+	map.invalidate();
+	QVERIFY(!map.isValid());
+	map.update(windowSize, caption, exclusions(), 1.0);
+	QVERIFY(map.isValid());
+}
+
+// a WM_NCHITTEST on a grid of positions over the whole window, at 150%
+void TestHitTestMap::benchmarkHitTest()
+{
+	auto map = new_map(1.5);
+	QVector<QPoint> positions;
+	for (auto y = 0; y < 900; y += 7)
+		for (auto x = 0; x < 1200; x += 7)
+			positions.append(QPoint(x, y));
+
+	auto captions = 0;
+	QBENCHMARK
+	{
+		BenchmarkSample sample("HitTestMap.HitTest");
+		for (const auto &position : positions)
+			captions += map.hitTest(position) == Windows::HitTestMap::Caption;
+	}
+	QVERIFY(captions > 0);
+	BenchmarkReport::instance().setValue("HitTestMap.HitTest.positions", positions.size());
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestHitTestMap)
+
+#include "tst_HitTestMap.moc"
\ No newline at end of file
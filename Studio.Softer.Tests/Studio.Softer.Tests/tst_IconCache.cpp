@@ -0,0 +1,164 @@
+#include "BenchmarkReport.h"
+#include "IconCache.h"
+
+#include <QTemporaryDir>
+#include <QPainter>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	const int iconCount = 8;
+
+	// a square picture of a colour, the bytes of its decoded image are size * size * 4
+	auto write_icon(const QString &path, int size, const QColor &color) -> bool {
+		QImage image(size, size, QImage::Format_ARGB32);
+		image.fill(color);
+		return image.save(path, "PNG");
+	}
+}
+
+/**
+* \brief The icons decoded once for the process, under a budget of bytes, and rasterized when they are painted.
+* The benchmark compares an icon of the cache with a QIcon read from the file, both painted at 32x32.
+*/
+class TestIconCache : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void init();
+	void cleanupTestCase();
+	void lazyIcon();
+	void missingFile();
+	void imageBudget();
+	void disabledIcon();
+	void benchmarkCachedIcon();
+	void benchmarkFileIcon();
+
+private:
+	QString iconPath(int index) const;
+
+	QTemporaryDir m_directory;
+};
+
+void TestIconCache::initTestCase()
+{
+	QVERIFY(m_directory.isValid());
+	for (auto i = 0; i < iconCount; ++i)
+		QVERIFY(write_icon(iconPath(i), 64, QColor::fromHsv(i * 40, 200, 200)));
+}
+
+void TestIconCache::init()
+{
+	auto &cache = Windows::IconCache::instance();
+	cache.clear();
+	cache.setByteBudget(4 * 1024 * 1024);
+}
+
+void TestIconCache::cleanupTestCase()
+{
+	Windows::IconCache::instance().clear();
+}
+
+QString TestIconCache::iconPath(int index) const
+{
+	return m_directory.filePath(QString("icon%1.png").arg(index));
+}
+
+// the icon decodes nothing until a pixmap is asked, which is then served by the cache
+void TestIconCache::lazyIcon()
+{
+	auto &cache = Windows::IconCache::instance();
+	auto icon = cache.icon(iconPath(0));
+	QCOMPARE(cache.decodedBytes(), 0);
+	QCOMPARE(cache.bytes(), 0);
+
+	auto pixmap = icon.pixmap(32, 32);
+	QCOMPARE(pixmap.size(), QSize(32, 32));
+	QCOMPARE(cache.decodedBytes(), 64 * 64 * 4);
+	QCOMPARE(cache.bytes(), 32 * 32 * 4);
+	QCOMPARE(icon.availableSizes(), QList<QSize>() << QSize(64, 64));
+
+	auto hits = cache.hits();
+	auto misses = cache.misses();
+	QCOMPARE(cache.icon(iconPath(0)).pixmap(32, 32).size(), QSize(32, 32));
+	QVERIFY(cache.hits() > hits);
+	QCOMPARE(cache.misses(), misses);
+	QCOMPARE(cache.bytes(), 32 * 32 * 4);
+}
+
+void TestIconCache::missingFile()
+{
+	auto icon = Windows::IconCache::instance().icon(m_directory.filePath("missing.png"));
+	QVERIFY(icon.pixmap(32, 32).isNull());
+	QVERIFY(icon.availableSizes().isEmpty());
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+	QVERIFY(icon.isNull());
+#endif
+}
+
+// the least recently used images are dropped above the budget, they are decoded again on their next use
+void TestIconCache::imageBudget()
+{
+	auto &cache = Windows::IconCache::instance();
+	const auto imageBytes = 64 * 64 * 4;
+	cache.setByteBudget(3 * imageBytes);
+
+	QStringList paths;
+	for (auto i = 0; i < iconCount; ++i)
+		paths.append(iconPath(i));
+	cache.warmUp(paths);
+	QTRY_COMPARE(cache.decodedBytes(), 3 * imageBytes);
+
+	QCOMPARE(cache.sizes(iconPath(0)), QList<QSize>() << QSize(64, 64));
+	QCOMPARE(cache.decodedBytes(), 3 * imageBytes);
+}
+
+// the disabled picture is generated by the style from the one of the cache
+void TestIconCache::disabledIcon()
+{
+	auto icon = Windows::IconCache::instance().icon(iconPath(1));
+	auto normal = icon.pixmap(32, 32).toImage();
+	auto disabled = icon.pixmap(32, 32, QIcon::Disabled).toImage();
+	QCOMPARE(disabled.size(), normal.size());
+	QVERIFY(disabled != normal);
+}
+
+void TestIconCache::benchmarkCachedIcon()
+{
+	QImage target(32, 32, QImage::Format_ARGB32_Premultiplied);
+	auto &cache = Windows::IconCache::instance();
+	QBENCHMARK
+	{
+		BenchmarkSample sample("IconCache.CachedIcon");
+		for (auto i = 0; i < iconCount; ++i)
+		{
+			QPainter painter(&target);
+			cache.icon(iconPath(i)).paint(&painter, target.rect());
+		}
+	}
+	BenchmarkReport::instance().setValue("IconCache.CachedIcon.bytes", cache.bytes());
+	BenchmarkReport::instance().setValue("IconCache.CachedIcon.decodedBytes", cache.decodedBytes());
+}
+
+// a QIcon of the file decodes it again for each icon
+void TestIconCache::benchmarkFileIcon()
+{
+	QImage target(32, 32, QImage::Format_ARGB32_Premultiplied);
+	QBENCHMARK
+	{
+		BenchmarkSample sample("IconCache.FileIcon");
+		for (auto i = 0; i < iconCount; ++i)
+		{
+			QPainter painter(&target);
+			QIcon(iconPath(i)).paint(&painter, target.rect());
+		}
+	}
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestIconCache)
+
+#include "tst_IconCache.moc"
\ No newline at end of file
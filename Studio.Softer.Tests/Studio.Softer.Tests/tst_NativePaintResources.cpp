@@ -0,0 +1,132 @@
+#include "BenchmarkReport.h"
+#include "NativePaintResources.h"
+
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	typedef Windows::NativePaintResources::Handle Handle;
+
+	// the handles given by the fake allocator, and the ones it was asked to release
+	struct Allocations
+	{
+		QVector<QRgb> created;
+		QVector<Handle> destroyed;
+	};
+
+	auto new_resources(Allocations &allocations) -> Windows::NativePaintResources * {
+		return new Windows::NativePaintResources(
+			[&allocations](QRgb color) -> Handle
+			{
+				allocations.created << color;
+				return reinterpret_cast<Handle>(quintptr(allocations.created.size()));
+			},
+			[&allocations](Handle handle) { allocations.destroyed << handle; });
+	}
+}
+
+/**
+* \brief The native brushes of the windows, created by a fake allocator instead of CreateSolidBrush.
+*/
+class TestNativePaintResources : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void oneBrushPerColour();
+	void releaseOnTheme();
+	void failedBrush();
+	void liveHandles();
+	void cleanupTestCase();
+};
+
+void TestNativePaintResources::oneBrushPerColour()
+{
+	Allocations allocations;
+	QScopedPointer<Windows::NativePaintResources> resources(new_resources(allocations));
+
+	auto red = resources->brush(Qt::red);
+	QVERIFY(red);
+	QCOMPARE(resources->brush(Qt::red), red);
+	QCOMPARE(resources->brush(QColor(255, 0, 0, 128)), red);
+	QVERIFY(resources->brush(Qt::blue) != red);
+	QCOMPARE(allocations.created, QVector<QRgb>() << QColor(Qt::red).rgb() << QColor(Qt::blue).rgb());
+	QCOMPARE(resources->brushCount(), 2);
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("Brush.Lookup");
+		resources->brush(Qt::red);
+	}
+	QCOMPARE(allocations.created.size(), 2);
+}
+
+// the brushes of the previous theme are released, the same theme keeps them
+void TestNativePaintResources::releaseOnTheme()
+{
+	Allocations allocations;
+	QScopedPointer<Windows::NativePaintResources> resources(new_resources(allocations));
+
+	resources->setTheme("dark");
+	auto background = resources->brush(QColor(48, 48, 48));
+	auto border = resources->brush(Qt::black);
+
+	resources->setTheme("dark");
+	QCOMPARE(resources->brushCount(), 2);
+	QVERIFY(allocations.destroyed.isEmpty());
+
+	resources->setTheme("light");
+	QCOMPARE(resources->theme(), QByteArray("light"));
+	QCOMPARE(resources->brushCount(), 0);
+	QCOMPARE(allocations.destroyed.size(), 2);
+	QVERIFY(allocations.destroyed.contains(background));
+	QVERIFY(allocations.destroyed.contains(border));
+
+	// the same colour under the new theme is another brush
+	QVERIFY(resources->brush(QColor(48, 48, 48)));
+	QCOMPARE(allocations.created.size(), 3);
+}
+
+void TestNativePaintResources::failedBrush()
+{
+	auto live = Windows::NativePaintResources::liveHandles();
+	Windows::NativePaintResources resources([](QRgb) -> Handle { return Q_NULLPTR; }, [](Handle) { QFAIL("No brush to release"); });
+
+	QVERIFY(!resources.brush(Qt::red));
+	QCOMPARE(resources.brushCount(), 0);
+	QCOMPARE(Windows::NativePaintResources::liveHandles(), live);
+}
+
+// the handles are counted for the process, released by the theme and by the destruction of their cache
+void TestNativePaintResources::liveHandles()
+{
+	QCOMPARE(Windows::NativePaintResources::liveHandles(), 0);
+
+	Allocations allocations;
+	{
+		QScopedPointer<Windows::NativePaintResources> resources(new_resources(allocations));
+		resources->brush(Qt::red);
+		resources->brush(Qt::green);
+		QCOMPARE(Windows::NativePaintResources::liveHandles(), 2);
+
+		resources->setTheme("light");
+		QCOMPARE(Windows::NativePaintResources::liveHandles(), 0);
+
+		resources->brush(Qt::blue);
+		QCOMPARE(Windows::NativePaintResources::liveHandles(), 1);
+	}
+
+	QCOMPARE(Windows::NativePaintResources::liveHandles(), 0);
+	QCOMPARE(allocations.destroyed.size(), allocations.created.size());
+}
+
+void TestNativePaintResources::cleanupTestCase()
+{
+	QCOMPARE(Windows::NativePaintResources::liveHandles(), 0);
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestNativePaintResources)
+
+#include "tst_NativePaintResources.moc"
\ No newline at end of file
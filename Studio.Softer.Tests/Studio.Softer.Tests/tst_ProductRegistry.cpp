@@ -0,0 +1,93 @@
+#include "BenchmarkReport.h"
+#include "ProductRegistry.h"
+
+#include <QLabel>
+#include <QLibrary>
+#include <QMainWindow>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	//The file of a product module next to the test, ie: libStudio.Softer.Designer.so.
+	auto module_path(ProductType product) -> QString {
+		QLibrary library(QCoreApplication::applicationDirPath() + QLatin1Char('/') + ProductRegistry::libraryName(product));
+		return library.load() ? library.fileName() : QString();
+	}
+}
+
+/**
+* \brief The products loaded on demand from their modules, ie: Studio.Softer.Designer.
+* A module that failed to load is not looked for again, its product uses the built-in content.
+*/
+class TestProductRegistry : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void noProduct();
+	void designerModule();
+	void missingModule();
+	void cleanupTestCase();
+
+private:
+	QString m_copiedModule;
+};
+
+void TestProductRegistry::noProduct()
+{
+	QVERIFY(!ProductRegistry::instance().contentFactory(None));
+}
+
+void TestProductRegistry::designerModule()
+{
+	auto factory = ProductRegistry::instance().contentFactory(Designer);
+	QVERIFY(factory);
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("Product.Content");
+		QScopedPointer<QWidget> content(factory(Q_NULLPTR));
+		sample.stop();
+
+		QVERIFY(qobject_cast<QMainWindow *>(content.data()));
+		QCOMPARE(content->objectName(), QString("Designer"));
+	}
+}
+
+void TestProductRegistry::missingModule()
+{
+	auto &registry = ProductRegistry::instance();
+	registry.registerBuiltin(Audio, [](QWidget *parent) -> QWidget * { return new QLabel("Audio", parent); });
+
+	//No module, the built-in content.
+	auto factory = registry.contentFactory(Audio);
+	QVERIFY(factory);
+	QScopedPointer<QWidget> content(factory(Q_NULLPTR));
+	QVERIFY(qobject_cast<QLabel *>(content.data()));
+
+	//A module deployed afterwards is not looked for, the failure is remembered until the process ends.
+	auto designer = module_path(Designer);
+	QVERIFY(!designer.isEmpty());
+	m_copiedModule = designer;
+	m_copiedModule.replace(ProductRegistry::libraryName(Designer), ProductRegistry::libraryName(Audio));
+	QFile::remove(m_copiedModule);
+	QVERIFY(QFile::copy(designer, m_copiedModule));
+
+	factory = registry.contentFactory(Audio);
+	QVERIFY(factory);
+	content.reset(factory(Q_NULLPTR));
+	QVERIFY(qobject_cast<QLabel *>(content.data()));
+	QVERIFY(!qobject_cast<QMainWindow *>(content.data()));
+}
+
+void TestProductRegistry::cleanupTestCase()
+{
+	if (!m_copiedModule.isEmpty())
+		QFile::remove(m_copiedModule);
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestProductRegistry)
+
+#include "tst_ProductRegistry.moc"
\ No newline at end of file
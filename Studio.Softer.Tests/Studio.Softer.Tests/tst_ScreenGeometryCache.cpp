@@ -0,0 +1,119 @@
+#include "BenchmarkReport.h"
+#include "ScreenGeometryCache.h"
+
+#include <QScreen>
+#include <QWindow>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	// two monitors side by side
+	auto monitor_geometry(quintptr screen) -> Windows::ScreenGeometry {
+		return screen == 2
+			? Windows::ScreenGeometry{ QRect(1920, 0, 2560, 1400), QRect(1920, 0, 2560, 1440), 1.5 }
+			: Windows::ScreenGeometry{ QRect(0, 0, 1920, 1040), QRect(0, 0, 1920, 1080), 1.0 };
+	}
+}
+
+/**
+* \brief The geometry of the screen of a window, served from the cache until the screen or the monitor changes.
+*/
+class TestScreenGeometryCache : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void sameMonitor();
+	void anotherMonitor();
+	void invalidate();
+	void screenSignals();
+
+private:
+	Windows::ScreenGeometryCache m_cache;
+	int m_calls;
+};
+
+void TestScreenGeometryCache::init()
+{
+	m_calls = 0;
+	m_cache.setProvider([this](QWindow *, quintptr screen)
+	{
+		++m_calls;
+		return monitor_geometry(screen);
+	});
+}
+
+void TestScreenGeometryCache::sameMonitor()
+{
+	QCOMPARE(m_cache.geometry(1).workArea, monitor_geometry(1).workArea);
+	QCOMPARE(m_cache.geometry(1).workArea, monitor_geometry(1).workArea);
+	QCOMPARE(m_calls, 1);
+}
+
+// a snap to another monitor asks for it before Qt reports the new screen, the cache is not trusted
+void TestScreenGeometryCache::anotherMonitor()
+{
+	QCOMPARE(m_cache.geometry(1).workArea, monitor_geometry(1).workArea);
+	QCOMPARE(m_cache.geometry(2).workArea, monitor_geometry(2).workArea);
+	QCOMPARE(m_cache.geometry(2).devicePixelRatio, 1.5);
+	QCOMPARE(m_calls, 2);
+
+	QCOMPARE(m_cache.geometry(1).screenRect, monitor_geometry(1).screenRect);
+	QCOMPARE(m_calls, 3);
+}
+
+void TestScreenGeometryCache::invalidate()
+{
+	m_cache.geometry(1);
+	m_cache.invalidate();
+	m_cache.geometry(1);
+	QCOMPARE(m_calls, 2);
+}
+
+// the signals of the screens and of the window clear the cache, as a monitor moved, resized or another one was reached
+void TestScreenGeometryCache::screenSignals()
+{
+	auto screen = QGuiApplication::primaryScreen();
+	QVERIFY(screen);
+
+	QWindow window;
+	Windows::ScreenGeometryCache cache;
+	cache.attach(&window);
+	cache.setProvider([this](QWindow *, quintptr screen)
+	{
+		++m_calls;
+		return monitor_geometry(screen);
+	});
+
+	cache.geometry(1);
+	cache.geometry(1);
+	QCOMPARE(m_calls, 1);
+
+	emit screen->geometryChanged(screen->geometry());
+	cache.geometry(1);
+	QCOMPARE(m_calls, 2);
+
+	emit screen->availableGeometryChanged(screen->availableGeometry());
+	cache.geometry(1);
+	QCOMPARE(m_calls, 3);
+
+	emit screen->logicalDotsPerInchChanged(screen->logicalDotsPerInch());
+	cache.geometry(1);
+	QCOMPARE(m_calls, 4);
+
+	emit window.screenChanged(screen);
+	cache.geometry(1);
+	QCOMPARE(m_calls, 5);
+
+	cache.geometry(1);
+	QCOMPARE(m_calls, 5);
+	QCOMPARE(cache.hits(), quint64(2));
+	QCOMPARE(cache.misses(), quint64(5));
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestScreenGeometryCache)
+
+#include "tst_ScreenGeometryCache.moc"
\ No newline at end of file
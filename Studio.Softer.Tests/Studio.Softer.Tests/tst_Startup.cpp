@@ -0,0 +1,339 @@
+#include "BenchmarkReport.h"
+#include "Application.h"
+#include "ProductRegistry.h"
+#include "SettingsStore.h"
+#include "StyleSheet.h"
+#include "Style_qss.h"
+#include "ThemeEngine.h"
+#include "Window.h"
+#include "WindowManager.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QProcess>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	const char applicationSwitch[] = "--application";
+	const char organizationName[] = "StudioSofterTests";
+	const char applicationName[] = "Startup";
+
+	//The application benchmarked by startup(), run in its own process since a process has a single QApplication.
+	auto run_application(int argc, char *argv[]) -> int {
+		QStandardPaths::setTestModeEnabled(true);
+
+		Application application(argc, argv);
+		application.setProductType(Designer);
+		application.setApplicationVersion("1.0.0.0");
+		application.setOrganizationName(organizationName);
+		application.setApplicationName(applicationName);
+		return application.exec();
+	}
+
+	//The built-in stylesheet with the tokens of the dark theme, the one of the application by default.
+	auto dark_style_sheet() -> Windows::StyleSheet {
+		return Windows::StyleSheet::fromTable(Styles::Style::table, Windows::ThemeEngine::instance().styleSheetVariables());
+	}
+
+	//The window of the application, its content is the designer loaded from Studio.Softer.Designer.
+	auto new_window() -> Windows::Window * {
+		auto window = new Windows::Window(Q_NULLPTR, ProductRegistry::instance().contentFactory(Designer));
+		window->setOrganizationName(organizationName);
+		window->setapplicationName(applicationName);
+		window->setThemeHash(dark_style_sheet().hash());
+		return window;
+	}
+}
+
+/**
+* \brief The startup of the application, from the construction of Application to the first frame of its window.
+* The phases are timed in process with QBENCHMARK, the whole startup in a child process through --startup-benchmark.
+*/
+class TestStartup : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+	void startup_data();
+	void startup();
+	void styleSheetApplication();
+	void windowConstruction();
+	void showWindow_data();
+	void showWindow();
+	void firstFrame();
+	void snapshotOfAnotherTheme();
+	void snapshotOfSameTheme();
+	void openWindows();
+
+private:
+	void setPersistedState(bool persisted);
+
+	QTemporaryDir m_directory;
+	QString m_styleSheet;
+};
+
+void TestStartup::initTestCase()
+{
+	QStandardPaths::setTestModeEnabled(true);
+	QVERIFY(m_directory.isValid());
+
+	Windows::SettingsStore::instance().load(organizationName, applicationName);
+	m_styleSheet = dark_style_sheet().text();
+	QVERIFY(!m_styleSheet.isEmpty());
+	QVERIFY(!m_styleSheet.contains('@'));
+	QVERIFY(ProductRegistry::instance().contentFactory(Designer));
+}
+
+void TestStartup::cleanupTestCase()
+{
+	QFile::remove(Windows::SettingsStore::instance().filePath());
+}
+
+// the snapshot written by a window closed at its default geometry, or no state at all
+void TestStartup::setPersistedState(bool persisted)
+{
+	auto &settings = Windows::SettingsStore::instance();
+	settings.remove("Window/Snapshot");
+	if (persisted)
+	{
+		QScopedPointer<Windows::Window> window(new_window());
+		window->showWindow();
+		QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+		window->close();
+		QVERIFY(settings.contains("Window/Snapshot"));
+	}
+	settings.sync();
+}
+
+void TestStartup::startup_data()
+{
+	QTest::addColumn<bool>("persisted");
+	QTest::newRow("cold") << false;
+	QTest::newRow("persisted") << true;
+}
+
+void TestStartup::startup()
+{
+	QFETCH(bool, persisted);
+	setPersistedState(persisted);
+	if (QTest::currentTestFailed()) return;
+	if (!persisted) QFile::remove(Windows::SettingsStore::instance().filePath());
+
+	auto benchmarkPath = m_directory.filePath(QString("startup-%1.json").arg(QTest::currentDataTag()));
+	auto environment = QProcessEnvironment::systemEnvironment();
+	environment.insert("QT_QPA_PLATFORM", QGuiApplication::platformName());
+
+	QProcess process;
+	process.setProcessEnvironment(environment);
+	process.setProcessChannelMode(QProcess::ForwardedChannels);
+	process.start(QCoreApplication::applicationFilePath(),
+		QStringList() << applicationSwitch << ("--startup-benchmark=" + benchmarkPath));
+	QVERIFY(process.waitForFinished(60000));
+	QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+	QCOMPARE(process.exitCode(), 0);
+
+	QFile file(benchmarkPath);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	auto root = QJsonDocument::fromJson(file.readAll()).object();
+	auto phases = root.value("phases").toObject();
+	auto events = root.value("events").toObject();
+	QCOMPARE(root.value("metadata").toObject().value("persistedState").toBool(), persisted);
+
+	auto &report = BenchmarkReport::instance();
+	for (const auto &phase : { "Application", "QApplication", "Stylesheet", "Window.Construct", "Window.Show" })
+	{
+		QVERIFY2(phases.contains(phase), phase);
+		report.setValue(QString("startup.%1.%2Ms").arg(QTest::currentDataTag(), phase), phases.value(phase).toDouble());
+	}
+	for (const auto &event : { "FirstFrame", "Window.ShellVisible", "Window.ContentReady" })
+	{
+		QVERIFY2(events.contains(event), event);
+		report.setValue(QString("startup.%1.%2Ms").arg(QTest::currentDataTag(), event), events.value(event).toDouble());
+	}
+}
+
+// the canonical text of the built-in theme, polished on a shown window as at startup
+void TestStartup::styleSheetApplication()
+{
+	QScopedPointer<Windows::Window> window(new_window());
+	window->showWindow();
+	QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("Stylesheet.Apply");
+		qApp->setStyleSheet(m_styleSheet);
+	}
+}
+
+// the shell and the Designer, which the window creates at once when it is given as content
+void TestStartup::windowConstruction()
+{
+	qApp->setStyleSheet(m_styleSheet);
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("Window.Construct");
+		Windows::Window window(Q_NULLPTR, ProductRegistry::instance().contentFactory(Designer)(Q_NULLPTR));
+		sample.stop();
+	}
+}
+
+void TestStartup::showWindow_data()
+{
+	QTest::addColumn<bool>("persisted");
+	QTest::newRow("cold") << false;
+	QTest::newRow("persisted") << true;
+}
+
+void TestStartup::showWindow()
+{
+	QFETCH(bool, persisted);
+	qApp->setStyleSheet(m_styleSheet);
+	setPersistedState(persisted);
+	if (QTest::currentTestFailed()) return;
+
+	QBENCHMARK
+	{
+		QScopedPointer<Windows::Window> window(new_window());
+		BenchmarkSample sample(QString("Window.Show.%1").arg(QTest::currentDataTag()));
+		window->showWindow();
+		QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+		sample.stop();
+		QCOMPARE(window->isMaximized(), false);
+	}
+}
+
+// from the construction of the window to the first paint of its shell, then to its content
+void TestStartup::firstFrame()
+{
+	qApp->setStyleSheet(m_styleSheet);
+	setPersistedState(false);
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("FirstFrame");
+		QScopedPointer<Windows::Window> window(new_window());
+		QSignalSpy shellVisible(window.data(), &Windows::Window::shellVisible);
+		QSignalSpy contentReady(window.data(), &Windows::Window::contentReady);
+		window->showWindow();
+		QTRY_VERIFY(shellVisible.count() > 0);
+		sample.stop();
+
+		QTRY_VERIFY(contentReady.count() > 0);
+		QVERIFY(window->shellVisibleTime() <= window->contentReadyTime());
+	}
+
+	auto &report = BenchmarkReport::instance();
+	QScopedPointer<Windows::Window> window(new_window());
+	window->showWindow();
+	QTRY_VERIFY(window->isContentReady());
+	report.setValue("shellVisibleMs", window->shellVisibleTime());
+	report.setValue("contentReadyMs", window->contentReadyTime());
+	report.setValue("layoutPasses", window->layoutPassCount());
+}
+
+// a snapshot written under another theme still gives the geometry, only the docks are laid out again
+void TestStartup::snapshotOfAnotherTheme()
+{
+	setPersistedState(false);
+	const QRect geometry(120, 140, 900, 600);
+	{
+		QScopedPointer<Windows::Window> window(new_window());
+		window->setThemeHash("another theme");
+		window->showWindow();
+		QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+		window->setGeometry(geometry);
+		window->close();
+	}
+
+	QScopedPointer<Windows::Window> window(new_window());
+	window->showWindow();
+	QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+	QCOMPARE(window->geometry().size(), geometry.size());
+	QTRY_VERIFY(window->isContentReady());
+	QVERIFY(window->layoutPassCount() > 0);
+}
+
+// a snapshot written under the same theme restores the docks and the content before their first layout
+void TestStartup::snapshotOfSameTheme()
+{
+	setPersistedState(false);
+	int coldPasses = 0;
+	{
+		QScopedPointer<Windows::Window> window(new_window());
+		window->showWindow();
+		QTRY_VERIFY(window->isContentReady());
+		QTest::qWait(50);
+		coldPasses = window->layoutPassCount();
+		window->close();
+	}
+
+	QScopedPointer<Windows::Window> window(new_window());
+	window->showWindow();
+	QTRY_VERIFY(window->isContentReady());
+	QTest::qWait(50);
+
+	auto &report = BenchmarkReport::instance();
+	report.setValue("layoutPasses.cold", coldPasses);
+	report.setValue("layoutPasses.warm", window->layoutPassCount());
+	QCOMPARE(window->layoutPassCount(), 1);
+	QVERIFY(window->layoutPassCount() <= coldPasses);
+}
+
+// the next windows share the theme, the icon and the menus of the first one, only their shell and content are built
+void TestStartup::openWindows()
+{
+	qApp->setStyleSheet(m_styleSheet);
+	setPersistedState(false);
+
+	WindowManager manager;
+	manager.setContentFactory(ProductRegistry::instance().contentFactory(Designer));
+	manager.setApplicationInfo(organizationName, applicationName);
+	manager.setThemeHash(dark_style_sheet().hash());
+	auto fileMenu = manager.addMenu("&File");
+
+	const int count = 4;
+	QVector<qint64> times;
+	QElapsedTimer clock;
+	for (auto i = 0; i < count; ++i)
+	{
+		clock.start();
+		auto window = manager.openWindow();
+		QTRY_VERIFY(window->isContentReady());
+		times << clock.elapsed();
+
+		auto menuBar = window->findChild<QMenuBar *>("windowMenuBar");
+		QVERIFY(menuBar);
+		QCOMPARE(menuBar->actions().first()->menu(), fileMenu);
+	}
+	QCOMPARE(manager.windows().size(), count);
+
+	qint64 later = 0;
+	for (auto i = 1; i < count; ++i)
+		later += times.at(i);
+
+	auto &report = BenchmarkReport::instance();
+	report.setValue("Window.Open.firstMs", times.first());
+	report.setValue("Window.Open.laterMs", double(later) / (count - 1));
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1 && qstrcmp(argv[1], applicationSwitch) == 0)
+		return run_application(argc, argv);
+
+	QApplication application(argc, argv);
+	application.setAttribute(Qt::AA_Use96Dpi, true);
+	TestStartup test;
+	return Tests::exec(&test, argc, argv);
+}
+
+#include "tst_Startup.moc"
\ No newline at end of file
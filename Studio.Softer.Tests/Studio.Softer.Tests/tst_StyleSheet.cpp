@@ -0,0 +1,336 @@
+#include "BenchmarkReport.h"
+#include "StyleSheet.h"
+#include "Style_qss.h"
+#include "ThemeEngine.h"
+#include "Window.h"
+
+#include <QTemporaryDir>
+#include <QBuffer>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	auto cache_directory() -> QString {
+		return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/StudioSofter/themes";
+	}
+
+	auto cache_files() -> QStringList {
+		return QDir(cache_directory()).entryList(QStringList() << "*.qssc", QDir::Files);
+	}
+
+	auto write_file(const QString &path, const QByteArray &content) -> bool {
+		QFile file(path);
+		return file.open(QIODevice::WriteOnly) && file.write(content) == content.size();
+	}
+
+	// the subjects given to Studio.Softer.QssCompiler by --native, painted by the widgets themselves
+	auto is_native(const Windows::StyleRule &rule) -> bool {
+		static const QStringList natives = { "QPalette", "windowTitleBar", "titleBarIcon", "CaptionButton" };
+		return natives.contains(rule.objectName.isEmpty() ? rule.className : rule.objectName);
+	}
+}
+
+/**
+* \brief The compilation of a stylesheet and its cache on the disk.
+* The benchmarks compare the text read and applied as is with the cold and the warm load of the cache.
+* The built-in stylesheet is resolved with the tokens of the dark theme.
+*/
+class TestStyleSheet : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void init();
+	void compile();
+	void variables();
+	void table();
+	void nativeTables();
+	void warmLoad();
+	void themeCaches();
+	void changedSource();
+	void corruptCache();
+	void hugeCount();
+	void eviction();
+	void readAndApply();
+	void loadCold();
+	void loadWarm();
+
+private:
+	QTemporaryDir m_directory;
+	QByteArray m_source;
+	QString m_path;
+	QHash<QString, QString> m_variables;
+};
+
+void TestStyleSheet::initTestCase()
+{
+	QStandardPaths::setTestModeEnabled(true);
+	QVERIFY(m_directory.isValid());
+
+	QFile file(STUDIO_SOFTER_SOURCE_DIR "/Studio.Softer/Studio.Softer/Style.qss");
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	m_source = file.readAll();
+	m_path = m_directory.filePath("Style.qss");
+	m_variables = Windows::ThemeEngine::instance().styleSheetVariables();
+	QVERIFY(write_file(m_path, m_source));
+}
+
+void TestStyleSheet::init()
+{
+	QDir(cache_directory()).removeRecursively();
+}
+
+void TestStyleSheet::compile()
+{
+	auto styleSheet = Windows::StyleSheet::compile(
+		"/* comment */ @hover: #404040;\n"
+		"QToolButton#minimizeButton:hover, QToolButton#closeButton:hover { background-color: @hover; }\n"
+		"QMenu { padding: 2px; }");
+
+	QCOMPARE(styleSheet.rules().size(), 3);
+	QVERIFY(!styleSheet.text().contains("comment"));
+	QVERIFY(!styleSheet.text().contains("@hover"));
+	QCOMPARE(styleSheet.rulesForObjectName("closeButton").size(), 1);
+	QCOMPARE(styleSheet.rulesForClass("QMenu").size(), 1);
+
+	auto declarations = styleSheet.declarations("QToolButton#minimizeButton:hover");
+	QCOMPARE(declarations.size(), 1);
+	QCOMPARE(declarations.first().second, QString("#404040"));
+}
+
+// the variables given by the caller are replaced as the ones of the source, which hide them
+void TestStyleSheet::variables()
+{
+	QHash<QString, QString> variables;
+	variables.insert("hover", "#000000");
+	variables.insert("menu.background", "#424242");
+	variables.insert("menuBar.spacing", "10px");
+
+	const QByteArray source =
+		"@hover: #404040;\n"
+		"QMenu { background-color: @menu.background; border-color: @hover; color: @window.text; }\n"
+		"QMenuBar { spacing: @menuBar.spacing; }";
+	auto styleSheet = Windows::StyleSheet::compile(source, variables);
+
+	auto declarations = styleSheet.declarations("QMenu");
+	QCOMPARE(declarations.size(), 3);
+	QCOMPARE(declarations[0].second, QString("#424242"));
+	QCOMPARE(declarations[1].second, QString("#404040"));
+	QCOMPARE(declarations[2].second, QString("@window.text"));
+	QCOMPARE(styleSheet.declarations("QMenuBar").first().second, QString("10px"));
+
+	QCOMPARE(styleSheet.hash(), Windows::StyleSheet::hashOf(source, variables));
+	QVERIFY(styleSheet.hash() != Windows::StyleSheet::hashOf(source));
+	QCOMPARE(Windows::StyleSheet::compile(source).hash(), Windows::StyleSheet::hashOf(source));
+}
+
+// the tables keep the tokens, resolved as the source compiled at runtime, every token of the source has a value,
+// the native rules are left out of the text given to Qt
+void TestStyleSheet::table()
+{
+	auto compiled = Windows::StyleSheet::compile(m_source, m_variables);
+	auto table = Windows::StyleSheet::fromTable(Styles::Style::table, m_variables);
+
+	QString text;
+	auto rules = 0;
+	for (const auto &rule : compiled.rules())
+	{
+		if (is_native(rule)) continue;
+		text += rule.selector + '{';
+		for (const auto &declaration : rule.declarations)
+			text += declaration.first + ':' + declaration.second + ';';
+		text += '}';
+		++rules;
+	}
+
+	QCOMPARE(table.hash(), compiled.hash());
+	QCOMPARE(table.text(), text);
+	QCOMPARE(table.rules().size(), rules);
+	QVERIFY(rules < compiled.rules().size());
+	QVERIFY(!table.text().contains("windowTitleBar"));
+	QVERIFY(!table.text().contains('@'));
+	QVERIFY(Windows::StyleSheet::fromTable(Styles::Style::table).text().contains("@panel.background"));
+}
+
+// the native rules are typed colours and metrics by subject and pseudo-state, resolved with the current theme
+void TestStyleSheet::nativeTables()
+{
+	auto &themes = Windows::ThemeEngine::instance();
+	themes.setStyleTable(&Styles::Style::table);
+
+	QCOMPARE(themes.styleColor("CaptionButton", "hover", "background-color", Qt::black), themes.color(Windows::ThemeEngine::CaptionHover));
+	QCOMPARE(themes.styleColor("CaptionButton", "pressed", "background-color", Qt::black), themes.color(Windows::ThemeEngine::CaptionPressed));
+	QCOMPARE(themes.styleColor("titleBarIcon", "hover", "background-color", Qt::black), QColor(Qt::transparent));
+	QCOMPARE(themes.styleColor("windowTitleBar", "", "background-color", Qt::black), themes.color(Windows::ThemeEngine::TitleBarBackground));
+	QCOMPARE(themes.styleMetric("windowTitleBar", "", "border-bottom-width", 0), 1);
+	QCOMPARE(themes.styleColor("windowTitleBar", "hover", "background-color", Qt::black), QColor(Qt::black));
+	QCOMPARE(themes.styleTokens("windowTitleBar", {}), QVector<Windows::ThemeEngine::Token>({ Windows::ThemeEngine::TitleBarBackground, Windows::ThemeEngine::Border }));
+	QCOMPARE(themes.palette().color(QPalette::ToolTipBase), themes.color(Windows::ThemeEngine::ToolTipBackground));
+
+	// the title bar and the caption buttons of a window read them
+	QScopedPointer<Windows::Window> window(new Windows::Window(Q_NULLPTR, Windows::ContentHost::ContentFactory()));
+	auto close = window->findChild<Windows::CaptionButton *>("closeButton");
+	QVERIFY(close);
+	QCOMPARE(close->hoverColor(), themes.color(Windows::ThemeEngine::CaptionHover));
+
+	auto titleBar = window->findChild<QWidget *>("windowTitleBar");
+	titleBar->resize(800, titleBar->height());
+	auto picture = titleBar->grab().toImage();
+	QCOMPARE(picture.pixelColor(picture.width() / 2, 5), themes.color(Windows::ThemeEngine::TitleBarBackground));
+	QCOMPARE(picture.pixelColor(picture.width() / 2, picture.height() - 1), themes.color(Windows::ThemeEngine::Border));
+
+	themes.setStyleTable(Q_NULLPTR);
+	BenchmarkReport::instance().setValue("StyleSheet.Table.nativeColors", Styles::Style::table.colorCount);
+	BenchmarkReport::instance().setValue("StyleSheet.Table.nativeMetrics", Styles::Style::table.metricCount);
+}
+
+// the second load reads the cache only, and gives the same stylesheet as the first
+void TestStyleSheet::warmLoad()
+{
+	auto cold = Windows::StyleSheet::load(m_path, m_variables);
+	QVERIFY(!cold.isEmpty());
+	QVERIFY(!cold.isFromCache());
+	QCOMPARE(cache_files().size(), 1);
+
+	auto warm = Windows::StyleSheet::load(m_path, m_variables);
+	QVERIFY(warm.isFromCache());
+	QCOMPARE(warm.hash(), cold.hash());
+	QCOMPARE(warm.hash(), Windows::StyleSheet::hashOf(m_source, m_variables));
+	QCOMPARE(warm.text(), cold.text());
+	QCOMPARE(warm.rules().size(), cold.rules().size());
+	QCOMPARE(warm.rulesForObjectName("closeButton").size(), cold.rulesForObjectName("closeButton").size());
+}
+
+// each theme has its own cache of the same source, a switch back is still a warm load
+void TestStyleSheet::themeCaches()
+{
+	auto light = m_variables;
+	light.insert("panel.background", "#ebebeb");
+
+	auto dark = Windows::StyleSheet::load(m_path, m_variables);
+	QVERIFY(!Windows::StyleSheet::load(m_path, light).isFromCache());
+	QCOMPARE(cache_files().size(), 2);
+
+	QVERIFY(Windows::StyleSheet::load(m_path, m_variables).isFromCache());
+	auto lightWarm = Windows::StyleSheet::load(m_path, light);
+	QVERIFY(lightWarm.isFromCache());
+	QVERIFY(lightWarm.hash() != dark.hash());
+	QVERIFY(lightWarm.text().contains("#ebebeb"));
+}
+
+void TestStyleSheet::changedSource()
+{
+	auto path = m_directory.filePath("Changed.qss");
+	QVERIFY(write_file(path, "QMenu { padding: 2px; }"));
+	QVERIFY(!Windows::StyleSheet::load(path).isFromCache());
+
+	QVERIFY(write_file(path, "QMenu { padding: 2px; }\nQToolTip { padding: 4px; }"));
+	auto changed = Windows::StyleSheet::load(path);
+	QVERIFY(!changed.isFromCache());
+	QCOMPARE(changed.rules().size(), 2);
+	QCOMPARE(cache_files().size(), 1);
+}
+
+// a damaged cache file is compiled again from the source, and replaced
+void TestStyleSheet::corruptCache()
+{
+	auto cold = Windows::StyleSheet::load(m_path, m_variables);
+	auto files = cache_files();
+	QCOMPARE(files.size(), 1);
+
+	auto cachePath = QDir(cache_directory()).filePath(files.first());
+	QFile cache(cachePath);
+	QVERIFY(cache.open(QIODevice::ReadOnly));
+	auto content = cache.readAll();
+	cache.close();
+	QVERIFY(write_file(cachePath, content.left(content.size() / 2)));
+
+	auto loaded = Windows::StyleSheet::load(m_path, m_variables);
+	QVERIFY(!loaded.isFromCache());
+	QCOMPARE(loaded.text(), cold.text());
+	QVERIFY(Windows::StyleSheet::load(m_path, m_variables).isFromCache());
+}
+
+// the counts of a stream are checked against its size before anything is allocated
+void TestStyleSheet::hugeCount()
+{
+	QByteArray data;
+	{
+		QDataStream stream(&data, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << quint32(0x51535343) << quint16(1) << QByteArray("hash") << QString("text") << quint32(0xfffffff0);
+	}
+
+	QBuffer buffer(&data);
+	QVERIFY(buffer.open(QIODevice::ReadOnly));
+	QDataStream stream(&buffer);
+	stream.setVersion(QDataStream::Qt_5_6);
+	Windows::StyleSheet styleSheet;
+	stream >> styleSheet;
+	QCOMPARE(stream.status(), QDataStream::ReadCorruptData);
+	QVERIFY(styleSheet.rules().isEmpty());
+}
+
+void TestStyleSheet::eviction()
+{
+	for (auto i = 0; i < 20; ++i)
+	{
+		auto path = m_directory.filePath(QString("Evicted%1.qss").arg(i));
+		QVERIFY(write_file(path, QString("QMenu { padding: %1px; }").arg(i).toUtf8()));
+		QVERIFY(!Windows::StyleSheet::load(path).isEmpty());
+	}
+	QCOMPARE(cache_files().size(), 16);
+}
+
+// the source read and given to Qt as is, without the cache
+void TestStyleSheet::readAndApply()
+{
+	Windows::Window window(Q_NULLPTR);
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("Stylesheet.ReadAndApply");
+		QFile file(m_path);
+		QVERIFY(file.open(QIODevice::ReadOnly));
+		qApp->setStyleSheet(Windows::StyleSheet::compile(file.readAll(), m_variables).text());
+	}
+}
+
+void TestStyleSheet::loadCold()
+{
+	Windows::Window window(Q_NULLPTR);
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+	QBENCHMARK
+	{
+		QDir(cache_directory()).removeRecursively();
+		BenchmarkSample sample("Stylesheet.LoadCold");
+		qApp->setStyleSheet(Windows::StyleSheet::load(m_path, m_variables).text());
+	}
+}
+
+void TestStyleSheet::loadWarm()
+{
+	Windows::Window window(Q_NULLPTR);
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+	Windows::StyleSheet::load(m_path, m_variables);
+
+	QBENCHMARK
+	{
+		BenchmarkSample sample("Stylesheet.LoadWarm");
+		auto styleSheet = Windows::StyleSheet::load(m_path, m_variables);
+		QVERIFY(styleSheet.isFromCache());
+		qApp->setStyleSheet(styleSheet.text());
+	}
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestStyleSheet)
+
+#include "tst_StyleSheet.moc"
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "BenchmarkReport.h"
+#include "StyleSheetReloader.h"
+
+#include <QVBoxLayout>
+#include <QToolButton>
+#include <QLabel>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	const char *const applicationStyleSheet =
+		"QToolButton { color: #101010; padding: 2px; }\n"
+		"QToolButton#closeButton { color: #e81123; }\n"
+		"QLabel { color: #202020; }\n"
+		"QFrame { border: none; }\n"
+		"#titleLabel { margin: 4px; }";
+}
+
+/**
+* \brief A stylesheet reloaded while the application runs, the changed rules are set on the matched
+* widgets only while they give the same result as the whole stylesheet of the application.
+*/
+class TestStyleSheetReloader : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void init();
+	void cleanup();
+	void overrideMatchedWidgets();
+	void lessSpecificRule();
+	void moreSpecificRuleChanged();
+	void sameSpecificityLater();
+	void otherProperty();
+	void sharedProperty();
+	void universalRule();
+	void removedProperty();
+
+private:
+	auto reloaded(const char *from, const char *to) const -> QString;
+
+	QScopedPointer<QWidget> m_panel;
+	QToolButton *m_closeButton;
+	QToolButton *m_toolButton;
+	QLabel *m_titleLabel;
+	QScopedPointer<Windows::StyleSheetReloader> m_reloader;
+};
+
+void TestStyleSheetReloader::init()
+{
+	qApp->setStyleSheet(Windows::StyleSheet::compile(applicationStyleSheet).text());
+	m_reloader.reset(new Windows::StyleSheetReloader(Windows::StyleSheet::compile(applicationStyleSheet)));
+
+	m_panel.reset(new QWidget);
+	auto layout = new QVBoxLayout(m_panel.data());
+	m_closeButton = new QToolButton(m_panel.data());
+	m_closeButton->setObjectName("closeButton");
+	m_toolButton = new QToolButton(m_panel.data());
+	m_titleLabel = new QLabel(m_panel.data());
+	m_titleLabel->setObjectName("titleLabel");
+	layout->addWidget(m_closeButton);
+	layout->addWidget(m_toolButton);
+	layout->addWidget(m_titleLabel);
+}
+
+void TestStyleSheetReloader::cleanup()
+{
+	m_panel.reset();
+	m_reloader.reset();
+	qApp->setStyleSheet(QString());
+}
+
+// a rule of the application replaced by another text
+auto TestStyleSheetReloader::reloaded(const char *from, const char *to) const -> QString
+{
+	return QString(applicationStyleSheet).replace(from, to);
+}
+
+// a more specific rule changed, the widgets it matches get it as their own stylesheet
+void TestStyleSheetReloader::overrideMatchedWidgets()
+{
+	auto before = qApp->styleSheet();
+	auto touched = m_reloader->apply(Windows::StyleSheet::compile(reloaded("#e81123", "#f1707a")));
+
+	QCOMPARE(m_reloader->lastChangedSelectors(), 1);
+	QCOMPARE(touched, 1);
+	QCOMPARE(qApp->styleSheet(), before);
+	QVERIFY(m_closeButton->styleSheet().contains("#f1707a"));
+	QVERIFY(m_toolButton->styleSheet().isEmpty());
+}
+
+// the close button keeps its colour from the more specific rule, only a new application stylesheet gives it
+void TestStyleSheetReloader::lessSpecificRule()
+{
+	auto styleSheet = Windows::StyleSheet::compile(reloaded("#101010", "#303030"));
+	auto touched = m_reloader->apply(styleSheet);
+
+	QCOMPARE(touched, QApplication::allWidgets().size());
+	QCOMPARE(qApp->styleSheet(), styleSheet.text());
+	QVERIFY(m_closeButton->styleSheet().isEmpty());
+	QVERIFY(m_toolButton->styleSheet().isEmpty());
+}
+
+// both rules of the close button changed, as by a switch of theme, it gets both of them in their order
+void TestStyleSheetReloader::moreSpecificRuleChanged()
+{
+	auto before = qApp->styleSheet();
+	auto styleSheet = QString(applicationStyleSheet).replace("#101010", "#303030").replace("#e81123", "#f1707a");
+	auto touched = m_reloader->apply(Windows::StyleSheet::compile(styleSheet.toUtf8()));
+
+	QCOMPARE(m_reloader->lastChangedSelectors(), 2);
+	QCOMPARE(touched, 2);
+	QCOMPARE(qApp->styleSheet(), before);
+	QVERIFY(m_toolButton->styleSheet().contains("#303030"));
+	QVERIFY(m_closeButton->styleSheet().indexOf("#303030") < m_closeButton->styleSheet().indexOf("#f1707a"));
+	QVERIFY(m_titleLabel->styleSheet().isEmpty());
+}
+
+// a label is a frame, the rule of QFrame is as specific and comes after the one of QLabel
+void TestStyleSheetReloader::sameSpecificityLater()
+{
+	auto styleSheet = Windows::StyleSheet::compile(reloaded("QLabel { color: #202020; }", "QLabel { color: #202020; border: 1px solid; }"));
+	m_reloader->apply(styleSheet);
+
+	QCOMPARE(qApp->styleSheet(), styleSheet.text());
+	QVERIFY(m_titleLabel->styleSheet().isEmpty());
+}
+
+// the other rules of the label set other properties, the override is kept
+void TestStyleSheetReloader::otherProperty()
+{
+	auto before = qApp->styleSheet();
+	auto touched = m_reloader->apply(Windows::StyleSheet::compile(reloaded("margin: 4px", "margin: 6px")));
+
+	QCOMPARE(touched, 1);
+	QCOMPARE(qApp->styleSheet(), before);
+	QVERIFY(m_titleLabel->styleSheet().contains("margin:6px"));
+	QVERIFY(m_closeButton->styleSheet().isEmpty());
+}
+
+// the whole rule is set on the widget, its colour would also beat the one of the close button
+void TestStyleSheetReloader::sharedProperty()
+{
+	auto styleSheet = Windows::StyleSheet::compile(reloaded("padding: 2px", "padding: 3px"));
+	m_reloader->apply(styleSheet);
+
+	QCOMPARE(qApp->styleSheet(), styleSheet.text());
+	QVERIFY(m_closeButton->styleSheet().isEmpty());
+	QVERIFY(m_toolButton->styleSheet().isEmpty());
+}
+
+// a rule of every widget replaces the stylesheet of the application instead of one per widget
+void TestStyleSheetReloader::universalRule()
+{
+	auto styleSheet = Windows::StyleSheet::compile(QByteArray(applicationStyleSheet) + "\nQWidget { font-size: 9pt; }");
+	m_reloader->apply(styleSheet);
+	QCOMPARE(qApp->styleSheet(), styleSheet.text());
+	QVERIFY(m_titleLabel->styleSheet().isEmpty());
+
+	styleSheet = Windows::StyleSheet::compile(QByteArray(applicationStyleSheet) + "\n* { font-size: 10pt; }");
+	m_reloader->apply(styleSheet);
+	QCOMPARE(qApp->styleSheet(), styleSheet.text());
+}
+
+void TestStyleSheetReloader::removedProperty()
+{
+	auto styleSheet = Windows::StyleSheet::compile(reloaded("#titleLabel { margin: 4px; }", "#titleLabel { }"));
+	m_reloader->apply(styleSheet);
+	QCOMPARE(qApp->styleSheet(), styleSheet.text());
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestStyleSheetReloader)
+
+#include "tst_StyleSheetReloader.moc"
\ No newline at end of file
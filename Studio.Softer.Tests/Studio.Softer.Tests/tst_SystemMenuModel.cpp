@@ -0,0 +1,150 @@
+#include "BenchmarkReport.h"
+#include "SystemMenuModel.h"
+
+#include <QMenu>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+typedef Windows::SystemMenuModel::Command Command;
+Q_DECLARE_METATYPE(Command)
+
+namespace {
+	// the Qt menu has no system move nor resize before Qt 5.15
+#if defined(Q_OS_WIN) || QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	const bool systemMoveSupported = true;
+#else
+	const bool systemMoveSupported = false;
+#endif
+
+	auto action_of(QMenu *menu, Command command) -> QAction * {
+		for (auto action : menu->actions())
+		{
+			if (!action->isSeparator() && action->data().toInt() == command)
+				return action;
+		}
+		return Q_NULLPTR;
+	}
+}
+
+/**
+* \brief The items of the system menu for each window state, and their rendering in a Qt menu.
+*/
+class TestSystemMenuModel : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void update_data();
+	void update();
+	void activeState();
+	void render();
+	void renderAfterUpdate();
+};
+
+void TestSystemMenuModel::update_data()
+{
+	QTest::addColumn<Qt::WindowStates>("state");
+	QTest::addColumn<bool>("restore");
+	QTest::addColumn<bool>("moveAndSize");
+	QTest::addColumn<bool>("minimize");
+	QTest::addColumn<bool>("maximize");
+	QTest::addColumn<Command>("defaultCommand");
+
+	QTest::newRow("normal") << Qt::WindowStates(Qt::WindowNoState) << false << systemMoveSupported << true << true << Windows::SystemMenuModel::Close;
+	QTest::newRow("maximized") << Qt::WindowStates(Qt::WindowMaximized) << true << false << true << false << Windows::SystemMenuModel::Close;
+	QTest::newRow("minimized") << Qt::WindowStates(Qt::WindowMinimized) << true << systemMoveSupported << false << true << Windows::SystemMenuModel::Restore;
+	QTest::newRow("fullscreen") << Qt::WindowStates(Qt::WindowFullScreen) << true << false << true << false << Windows::SystemMenuModel::Close;
+	QTest::newRow("minimized from maximized") << (Qt::WindowMinimized | Qt::WindowMaximized) << true << systemMoveSupported << false << true << Windows::SystemMenuModel::Restore;
+}
+
+void TestSystemMenuModel::update()
+{
+	QFETCH(Qt::WindowStates, state);
+	QFETCH(bool, restore);
+	QFETCH(bool, moveAndSize);
+	QFETCH(bool, minimize);
+	QFETCH(bool, maximize);
+	QFETCH(Command, defaultCommand);
+
+	Windows::SystemMenuModel model;
+	QCOMPARE(model.revision(), quint64(0));
+	QVERIFY(model.update(state));
+	QCOMPARE(model.revision(), quint64(1));
+
+	QCOMPARE(model.items().size(), 6);
+	QCOMPARE(model.isEnabled(Windows::SystemMenuModel::Restore), restore);
+	QCOMPARE(model.isEnabled(Windows::SystemMenuModel::Move), moveAndSize);
+	QCOMPARE(model.isEnabled(Windows::SystemMenuModel::Size), moveAndSize);
+	QCOMPARE(model.isEnabled(Windows::SystemMenuModel::Minimize), minimize);
+	QCOMPARE(model.isEnabled(Windows::SystemMenuModel::Maximize), maximize);
+	QVERIFY(model.isEnabled(Windows::SystemMenuModel::Close));
+	QCOMPARE(model.defaultCommand(), defaultCommand);
+
+	// the same state again does not change the revision
+	QVERIFY(!model.update(state));
+	QCOMPARE(model.revision(), quint64(1));
+}
+
+// the activation of the window does not change the menu, a renderer keeps its items
+void TestSystemMenuModel::activeState()
+{
+	Windows::SystemMenuModel model;
+	model.update(Qt::WindowNoState);
+	QVERIFY(!model.update(Qt::WindowActive));
+	QCOMPARE(model.revision(), quint64(1));
+
+	model.update(Qt::WindowMaximized);
+	QVERIFY(!model.update(Qt::WindowMaximized | Qt::WindowActive));
+	QCOMPARE(model.revision(), quint64(2));
+}
+
+void TestSystemMenuModel::render()
+{
+	Windows::SystemMenuModel model;
+	model.update(Qt::WindowNoState);
+
+	QMenu menu;
+	model.render(&menu);
+	QCOMPARE(menu.actions().size(), 7);
+	QVERIFY(menu.actions().at(5)->isSeparator());
+
+	for (const auto &item : model.items())
+	{
+		auto action = action_of(&menu, item.command);
+		QVERIFY(action);
+		QCOMPARE(action->text(), Windows::SystemMenuModel::text(item.command));
+		QCOMPARE(action->isEnabled(), item.enabled);
+	}
+	QCOMPARE(menu.defaultAction(), action_of(&menu, Windows::SystemMenuModel::Close));
+	QCOMPARE(action_of(&menu, Windows::SystemMenuModel::Close)->shortcut(), QKeySequence(Qt::ALT + Qt::Key_F4));
+}
+
+// the actions are created once, a render after a state change only updates them
+void TestSystemMenuModel::renderAfterUpdate()
+{
+	Windows::SystemMenuModel model;
+	model.update(Qt::WindowNoState);
+
+	QMenu menu;
+	model.render(&menu);
+	auto actions = menu.actions();
+
+	model.update(Qt::WindowMinimized);
+	model.render(&menu);
+	QCOMPARE(menu.actions(), actions);
+	QVERIFY(action_of(&menu, Windows::SystemMenuModel::Restore)->isEnabled());
+	QVERIFY(!action_of(&menu, Windows::SystemMenuModel::Minimize)->isEnabled());
+	QCOMPARE(menu.defaultAction(), action_of(&menu, Windows::SystemMenuModel::Restore));
+
+	model.update(Qt::WindowMaximized);
+	model.render(&menu);
+	QVERIFY(!action_of(&menu, Windows::SystemMenuModel::Maximize)->isEnabled());
+	QVERIFY(!action_of(&menu, Windows::SystemMenuModel::Move)->isEnabled());
+	QCOMPARE(menu.defaultAction(), action_of(&menu, Windows::SystemMenuModel::Close));
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestSystemMenuModel)
+
+#include "tst_SystemMenuModel.moc"
\ No newline at end of file
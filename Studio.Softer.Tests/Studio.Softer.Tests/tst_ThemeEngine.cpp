@@ -0,0 +1,313 @@
+#include "BenchmarkReport.h"
+#include "StyleSheetReloader.h"
+#include "StyleSheet.h"
+#include "ThemeEngine.h"
+
+#include <QVBoxLayout>
+#include <QPushButton>
+#include <QMenuBar>
+#include <QLabel>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	const int widgetCount = 10000;
+
+	// the stylesheet of a built-in theme, read from the sources instead of the tables of the application
+	auto theme_style_sheet(const Windows::Theme &theme) -> Windows::StyleSheet {
+		auto path = QString(STUDIO_SOFTER_SOURCE_DIR "/Studio.Softer/Studio.Softer/") + QFileInfo(theme.styleSheetPath).fileName();
+		return Windows::StyleSheet::load(path, Windows::ThemeEngine::instance().styleSheetVariables());
+	}
+
+	// the application follows the theme as in Application, once for the tests that need it
+	auto bind_application() -> Windows::StyleSheetReloader & {
+		static Windows::StyleSheetReloader *reloader = Q_NULLPTR;
+		if (!reloader)
+		{
+			Windows::ThemeEngine::instance().bindApplication(qApp, [](const Windows::Theme &theme)
+			{
+				if (reloader)
+				{
+					reloader->apply(theme_style_sheet(theme));
+					return;
+				}
+				qApp->setStyleSheet(theme_style_sheet(theme).text());
+				reloader = new Windows::StyleSheetReloader(theme_style_sheet(theme));
+			});
+		}
+		return *reloader;
+	}
+
+	// counts the events of a widget polished again, by a new stylesheet of its own or of the application
+	class PolishCounter : public QObject
+	{
+	public:
+		int polishes = 0;
+
+	protected:
+		bool eventFilter(QObject *watched, QEvent *event) override
+		{
+			if (event->type() == QEvent::Polish || event->type() == QEvent::StyleChange)
+				++polishes;
+			return QObject::eventFilter(watched, event);
+		}
+	};
+
+	// a panel of labels, each one painting its background with a token as the widgets of a product do
+	auto new_panel(int count) -> QWidget * {
+		auto &themes = Windows::ThemeEngine::instance();
+		auto panel = new QWidget;
+		auto layout = new QVBoxLayout(panel);
+		for (auto i = 0; i < count; ++i)
+		{
+			auto label = new QLabel(QString::number(i), panel);
+			label->setAutoFillBackground(true);
+			layout->addWidget(label);
+			themes.bind(label, { Windows::ThemeEngine::PanelBackground }, [label]()
+			{
+				auto palette = label->palette();
+				palette.setColor(QPalette::Window, Windows::ThemeEngine::instance().color(Windows::ThemeEngine::PanelBackground));
+				label->setPalette(palette);
+			});
+		}
+		return panel;
+	}
+}
+
+/**
+* \brief A switch of theme at runtime, applied to the application and to the bound widgets.
+* The benchmarks switch 10k bound widgets from the dark theme to the light one and back,
+* resolve the tokens of a theme alone and read them by index and by name. They run before
+* the application is bound, so that they do not measure its palette and its stylesheet.
+*/
+class TestThemeEngine : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void cleanup();
+	void widgetFollowsTheme();
+	void unchangedTokens();
+	void unknownTheme();
+	void styleSheetVariables();
+	void benchmarkSwitch();
+	void benchmarkResolve();
+	void benchmarkTokenLookup();
+	void benchmarkTokenLookupByName();
+	void applicationFollowsTheme();
+	void styleSheetFollowsTokens();
+	void otherWidgetsNotPolished();
+};
+
+void TestThemeEngine::initTestCase()
+{
+	QStandardPaths::setTestModeEnabled(true);
+	auto &themes = Windows::ThemeEngine::instance();
+	QCOMPARE(themes.themeName(), QString("dark"));
+}
+
+void TestThemeEngine::cleanup()
+{
+	Windows::ThemeEngine::instance().setTheme("dark");
+}
+
+void TestThemeEngine::widgetFollowsTheme()
+{
+	QScopedPointer<QWidget> panel(new_panel(3));
+	panel->show();
+	QVERIFY(QTest::qWaitForWindowExposed(panel.data()));
+
+	auto label = panel->findChild<QLabel *>();
+	QCOMPARE(label->palette().color(QPalette::Window), QColor("#383838"));
+
+	Windows::ThemeEngine::instance().setTheme("light");
+	QCOMPARE(label->palette().color(QPalette::Window), QColor("#ebebeb"));
+}
+
+// a theme with a single other token only calls its bindings
+void TestThemeEngine::unchangedTokens()
+{
+	auto &themes = Windows::ThemeEngine::instance();
+	auto theme = themes.theme();
+	theme.name = "dark.hover";
+	theme.tokens.insert("caption.hover", QColor("#505050"));
+	themes.addTheme(theme);
+
+	QScopedPointer<QWidget> panel(new_panel(10));
+	auto hovers = 0;
+	themes.bind(panel.data(), { Windows::ThemeEngine::CaptionHover }, [&hovers]() { ++hovers; });
+	QCOMPARE(hovers, 1);
+
+	QVERIFY(themes.setTheme("dark.hover"));
+	QCOMPARE(hovers, 2);
+	QCOMPARE(themes.lastUpdateCount(), 1);
+	QCOMPARE(themes.color(Windows::ThemeEngine::CaptionHover), QColor("#505050"));
+}
+
+
+void TestThemeEngine::unknownTheme()
+{
+	auto &themes = Windows::ThemeEngine::instance();
+	auto styleSheet = qApp->styleSheet();
+	QVERIFY(!themes.setTheme("unknown"));
+	QCOMPARE(themes.themeName(), QString("dark"));
+	QCOMPARE(qApp->styleSheet(), styleSheet);
+}
+
+// one variable per token, a colour by its name and a metric in pixels
+void TestThemeEngine::styleSheetVariables()
+{
+	auto variables = Windows::ThemeEngine::instance().styleSheetVariables();
+	QCOMPARE(variables.size(), int(Windows::ThemeEngine::TokenCount));
+	for (auto i = 0; i < Windows::ThemeEngine::TokenCount; ++i)
+		QVERIFY(variables.contains(Windows::ThemeEngine::tokenName(static_cast<Windows::ThemeEngine::Token>(i))));
+
+	QCOMPARE(variables.value("panel.background"), QString("#383838"));
+	QCOMPARE(variables.value("caption.hover"), QString("#404040"));
+	QCOMPARE(variables.value("menuBar.spacing"), QString("10px"));
+}
+
+void TestThemeEngine::benchmarkSwitch()
+{
+	QScopedPointer<QWidget> panel(new_panel(widgetCount));
+	panel->show();
+	QVERIFY(QTest::qWaitForWindowExposed(panel.data()));
+
+	auto &themes = Windows::ThemeEngine::instance();
+	QBENCHMARK
+	{
+		BenchmarkSample sample("ThemeEngine.Switch");
+		themes.setTheme("light");
+		themes.setTheme("dark");
+	}
+	QCOMPARE(themes.lastUpdateCount(), widgetCount);
+	BenchmarkReport::instance().setValue("ThemeEngine.Switch.widgets", widgetCount);
+	BenchmarkReport::instance().setValue("ThemeEngine.Switch.updates", themes.lastUpdateCount());
+}
+
+// a switch without any binding, the tokens of the theme resolved into the flat array and compared to the previous ones
+void TestThemeEngine::benchmarkResolve()
+{
+	auto &themes = Windows::ThemeEngine::instance();
+	QCOMPARE(themes.bindingCount(), 0);
+	QBENCHMARK
+	{
+		BenchmarkSample sample("ThemeEngine.Resolve");
+		themes.setTheme("light");
+		themes.setTheme("dark");
+	}
+	QCOMPARE(themes.lastUpdateCount(), 0);
+	BenchmarkReport::instance().setValue("ThemeEngine.Resolve.tokens", int(Windows::ThemeEngine::TokenCount));
+	BenchmarkReport::instance().setValue("ThemeEngine.Resolve.lastNs", themes.lastResolveTime());
+}
+
+// the flat array of the resolved tokens, as read by a widget that paints
+void TestThemeEngine::benchmarkTokenLookup()
+{
+	auto &themes = Windows::ThemeEngine::instance();
+	auto valid = 0;
+	QBENCHMARK
+	{
+		BenchmarkSample sample("ThemeEngine.TokenLookup");
+		for (auto i = 0; i < Windows::ThemeEngine::TokenCount; ++i)
+			valid += themes.color(static_cast<Windows::ThemeEngine::Token>(i)).isValid();
+	}
+	QVERIFY(valid > 0);
+	BenchmarkReport::instance().setValue("ThemeEngine.TokenLookup.tokens", int(Windows::ThemeEngine::TokenCount));
+}
+
+// a token of a theme file by name, found in the names of the tokens before the flat array
+void TestThemeEngine::benchmarkTokenLookupByName()
+{
+	QStringList names;
+	for (auto i = 0; i < Windows::ThemeEngine::TokenCount; ++i)
+		names.append(Windows::ThemeEngine::tokenName(static_cast<Windows::ThemeEngine::Token>(i)));
+
+	auto &themes = Windows::ThemeEngine::instance();
+	auto valid = 0;
+	QBENCHMARK
+	{
+		BenchmarkSample sample("ThemeEngine.TokenLookupByName");
+		for (const auto &name : names)
+			valid += themes.color(name).isValid();
+	}
+	QVERIFY(valid > 0);
+	BenchmarkReport::instance().setValue("ThemeEngine.TokenLookupByName.tokens", names.size());
+}
+
+// the light theme gives a light palette and the light rules, the stylesheet of the application is kept
+void TestThemeEngine::applicationFollowsTheme()
+{
+	auto &reloader = bind_application();
+	auto &themes = Windows::ThemeEngine::instance();
+	auto styleSheet = qApp->styleSheet();
+	QCOMPARE(styleSheet, theme_style_sheet(themes.theme()).text());
+	QCOMPARE(qApp->palette().color(QPalette::Window), themes.color(Windows::ThemeEngine::WindowBackground));
+
+	QScopedPointer<QMenuBar> menuBar(new QMenuBar);
+	QVERIFY(themes.setTheme("light"));
+	QCOMPARE(qApp->palette().color(QPalette::Window), QColor("#f0f0f0"));
+	QCOMPARE(qApp->palette().color(QPalette::WindowText), QColor("#202020"));
+	QCOMPARE(qApp->styleSheet(), styleSheet);
+	QVERIFY(reloader.lastChangedSelectors() > 0);
+	QVERIFY(menuBar->styleSheet().contains(themes.color(Windows::ThemeEngine::MenuBackground).name()));
+
+	QVERIFY(themes.setTheme("dark"));
+	QCOMPARE(qApp->styleSheet(), styleSheet);
+	QVERIFY(menuBar->styleSheet().isEmpty());
+}
+
+// a theme that only changes a token changes the rules that use it, the themes have no stylesheet of their own
+void TestThemeEngine::styleSheetFollowsTokens()
+{
+	auto &reloader = bind_application();
+	auto &themes = Windows::ThemeEngine::instance();
+	auto theme = themes.theme();
+	theme.name = "dark.toolBar";
+	theme.tokens.insert("toolBar.border", QColor("#123456"));
+	themes.addTheme(theme);
+
+	QScopedPointer<QWidget> toolBar(new QWidget);
+	toolBar->setObjectName("toolBar");
+	QVERIFY(!qApp->styleSheet().contains("#123456"));
+	QVERIFY(themes.setTheme("dark.toolBar"));
+	QCOMPARE(themes.lastUpdateCount(), 1);
+	QCOMPARE(reloader.lastChangedSelectors(), 1);
+	QCOMPARE(reloader.lastTouchedWidgets(), 1);
+	QVERIFY(toolBar->styleSheet().contains("#123456"));
+	QVERIFY(!toolBar->styleSheet().contains('@'));
+	QVERIFY(!qApp->styleSheet().contains("#123456"));
+}
+
+// a widget that no changed rule matches is neither polished again nor given a new style
+void TestThemeEngine::otherWidgetsNotPolished()
+{
+	bind_application();
+	QScopedPointer<QMenuBar> menuBar(new QMenuBar);
+	QScopedPointer<QWidget> panel(new QWidget);
+	auto layout = new QVBoxLayout(panel.data());
+	for (auto i = 0; i < 10; ++i)
+		layout->addWidget(new QPushButton(QString::number(i), panel.data()));
+	panel->show();
+	menuBar->show();
+	QVERIFY(QTest::qWaitForWindowExposed(panel.data()));
+
+	PolishCounter others, menus;
+	for (auto widget : panel->findChildren<QWidget *>() << panel.data())
+		widget->installEventFilter(&others);
+	menuBar->installEventFilter(&menus);
+
+	auto &themes = Windows::ThemeEngine::instance();
+	QVERIFY(themes.setTheme("light"));
+	QVERIFY(themes.setTheme("dark"));
+	QCOMPARE(others.polishes, 0);
+	QVERIFY(menus.polishes > 0);
+	BenchmarkReport::instance().setValue("ThemeEngine.Switch.polishedOthers", others.polishes);
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestThemeEngine)
+
+#include "tst_ThemeEngine.moc"
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "BenchmarkReport.h"
+#include "Window.h"
+
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	auto new_window() -> Windows::Window * {
+		auto window = new Windows::Window(Q_NULLPTR, Windows::ContentHost::ContentFactory());
+		window->setGeometry(100, 100, 800, 600);
+		return window;
+	}
+
+	// a point of the title bar that is not covered by the menu bar nor a button, in window coordinates
+	auto caption_point(Windows::Window *window) -> QPoint {
+		auto titleBar = window->findChild<QWidget *>("windowTitleBar");
+		if (!titleBar) return QPoint(-1, -1);
+
+		auto y = titleBar->height() / 2;
+		for (auto x = titleBar->width() / 2; x < titleBar->width(); ++x)
+		{
+			if (!titleBar->childAt(x, y))
+				return titleBar->mapTo(window, QPoint(x, y));
+		}
+		return QPoint(-1, -1);
+	}
+}
+
+/**
+* \brief The frame of the window on the platforms without nativeEvent, run under the offscreen platform.
+* The offscreen platform has no system move, the window is moved by the application as with Qt before 5.15.
+*/
+class TestWindow : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void init();
+	void cleanup();
+	void borderCursor();
+	void captionDrag();
+	void doubleClickCaption();
+	void contentClick();
+
+private:
+	QScopedPointer<Windows::Window> m_window;
+};
+
+void TestWindow::initTestCase()
+{
+#ifdef Q_OS_WIN
+	QSKIP("The frame is handled by nativeEvent on Windows");
+#endif
+	QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestWindow::init()
+{
+	m_window.reset(new_window());
+	m_window->show();
+	QVERIFY(QTest::qWaitForWindowExposed(m_window.data()));
+}
+
+void TestWindow::cleanup()
+{
+	m_window.reset();
+}
+
+void TestWindow::borderCursor()
+{
+	auto handle = m_window->windowHandle();
+	QTest::mouseMove(handle, QPoint(2, 300));
+	QTRY_COMPARE(m_window->cursor().shape(), Qt::SizeHorCursor);
+
+	QTest::mouseMove(handle, QPoint(2, 2));
+	QTRY_COMPARE(m_window->cursor().shape(), Qt::SizeFDiagCursor);
+
+	QTest::mouseMove(handle, QPoint(400, 300));
+	QTRY_COMPARE(m_window->cursor().shape(), Qt::ArrowCursor);
+}
+
+// the window follows the mouse from the press to the release, and no further
+void TestWindow::captionDrag()
+{
+	auto point = caption_point(m_window.data());
+	QVERIFY(point.x() >= 0);
+
+	auto handle = m_window->windowHandle();
+	auto start = m_window->pos();
+	QTest::mousePress(handle, Qt::LeftButton, Qt::NoModifier, point);
+
+	// the positions are relative to the press, wherever the window already moved
+	auto local = [this, point, start](const QPoint &offset) { return point + offset - (m_window->pos() - start); };
+	for (auto i = 1; i <= 10; ++i)
+		QTest::mouseMove(handle, local(QPoint(5 * i, 4 * i)));
+	QTRY_COMPARE(m_window->pos(), start + QPoint(50, 40));
+
+	QTest::mouseRelease(handle, Qt::LeftButton, Qt::NoModifier, local(QPoint(50, 40)));
+	QTest::mouseMove(handle, local(QPoint(70, 60)));
+	QTest::qWait(20);
+	QCOMPARE(m_window->pos(), start + QPoint(50, 40));
+}
+
+void TestWindow::doubleClickCaption()
+{
+	auto point = caption_point(m_window.data());
+	QVERIFY(point.x() >= 0);
+
+	QTest::mouseDClick(m_window->windowHandle(), Qt::LeftButton, Qt::NoModifier, point);
+	QTRY_VERIFY(m_window->isMaximized());
+
+	QTest::mouseDClick(m_window->windowHandle(), Qt::LeftButton, Qt::NoModifier, caption_point(m_window.data()));
+	QTRY_VERIFY(!m_window->isMaximized());
+}
+
+// the content keeps its mouse events, the window does not move
+void TestWindow::contentClick()
+{
+	auto handle = m_window->windowHandle();
+	auto start = m_window->pos();
+	QTest::mousePress(handle, Qt::LeftButton, Qt::NoModifier, QPoint(400, 300));
+	QTest::mouseMove(handle, QPoint(450, 350));
+	QTest::mouseRelease(handle, Qt::LeftButton, Qt::NoModifier, QPoint(450, 350));
+	QTest::qWait(20);
+	QCOMPARE(m_window->pos(), start);
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestWindow)
+
+#include "tst_Window.moc"
\ No newline at end of file
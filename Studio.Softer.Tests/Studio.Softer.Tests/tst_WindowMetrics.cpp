@@ -0,0 +1,121 @@
+#include "BenchmarkReport.h"
+#include "Window.h"
+
+#include <QScreen>
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	// the sizes of the frame in device independent pixels, see WindowMetrics
+	const int borderWidth = 8;
+	const int menuOffset = 30;
+
+	// the ratio of the screen, given by QT_SCALE_FACTOR under the offscreen platform
+	auto screen_ratio() -> qreal {
+		return QGuiApplication::primaryScreen()->devicePixelRatio();
+	}
+}
+
+/**
+* \brief The metrics of the frame at the device pixel ratio of the screen.
+* The test runs once per scale factor, see the QT_SCALE_FACTOR of its ctest runs.
+*/
+class TestWindowMetrics : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void setDevicePixelRatio_data();
+	void setDevicePixelRatio();
+	void scaleFactor();
+	void windowMetrics();
+	void screenChange();
+};
+
+void TestWindowMetrics::initTestCase()
+{
+	QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestWindowMetrics::setDevicePixelRatio_data()
+{
+	QTest::addColumn<qreal>("devicePixelRatio");
+	QTest::addColumn<int>("border");
+	QTest::addColumn<int>("offset");
+
+	QTest::newRow("100%") << 1.0 << 8 << 30;
+	QTest::newRow("125%") << 1.25 << 10 << 38;
+	QTest::newRow("150%") << 1.5 << 12 << 45;
+	QTest::newRow("200%") << 2.0 << 16 << 60;
+}
+
+// the values in device pixels follow the ratio, the layout in device independent pixels does not
+void TestWindowMetrics::setDevicePixelRatio()
+{
+	QFETCH(qreal, devicePixelRatio);
+	QFETCH(int, border);
+	QFETCH(int, offset);
+
+	Windows::WindowMetrics metrics;
+	auto titleBarHeight = metrics.titleBarHeight();
+	auto buttonSize = metrics.captionButtonSize();
+
+	QCOMPARE(metrics.setDevicePixelRatio(devicePixelRatio), !qFuzzyCompare(devicePixelRatio, 1.0));
+	QVERIFY(!metrics.setDevicePixelRatio(devicePixelRatio));
+	QCOMPARE(metrics.borderWidth(), border);
+	QCOMPARE(metrics.menuOffset(), offset);
+	QCOMPARE(metrics.titleBarHeight(), titleBarHeight);
+	QCOMPARE(metrics.captionButtonSize(), buttonSize);
+
+	// back to 100%, as on a move to another monitor
+	QCOMPARE(metrics.setDevicePixelRatio(1.0), !qFuzzyCompare(devicePixelRatio, 1.0));
+	QCOMPARE(metrics.borderWidth(), borderWidth);
+	QCOMPARE(metrics.menuOffset(), menuOffset);
+}
+
+// the ratio of the run is the one asked to ctest
+void TestWindowMetrics::scaleFactor()
+{
+	auto factor = qgetenv("QT_SCALE_FACTOR");
+	if (factor.isEmpty())
+		QSKIP("QT_SCALE_FACTOR is not set");
+
+	QCOMPARE(screen_ratio(), factor.toDouble());
+}
+
+// the window applies the ratio of its screen to the metrics and to its hit test map
+void TestWindowMetrics::windowMetrics()
+{
+	Windows::Window window(Q_NULLPTR);
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+	auto ratio = screen_ratio();
+	QCOMPARE(window.devicePixelRatioF(), ratio);
+	QCOMPARE(window.metrics().devicePixelRatio(), ratio);
+	QCOMPARE(window.metrics().borderWidth(), qRound(borderWidth * ratio));
+	QCOMPARE(window.metrics().menuOffset(), qRound(menuOffset * ratio));
+	QCOMPARE(window.hitTestMap().borderWidth(), window.metrics().borderWidth());
+	BenchmarkReport::instance().setValue("WindowMetrics.DevicePixelRatio", ratio);
+}
+
+// a screen change with the same ratio keeps the metrics
+void TestWindowMetrics::screenChange()
+{
+	Windows::Window window(Q_NULLPTR);
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+	auto border = window.hitTestMap().borderWidth();
+	QEvent event(QEvent::ScreenChangeInternal);
+	QApplication::sendEvent(&window, &event);
+	QCOMPARE(window.metrics().devicePixelRatio(), screen_ratio());
+	QCOMPARE(window.hitTestMap().borderWidth(), border);
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestWindowMetrics)
+
+#include "tst_WindowMetrics.moc"
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "BenchmarkReport.h"
+#include "Window.h"
+#include "WindowStateAnimator.h"
+
+#include <QtTest>
+
+using namespace Studio::Softer;
+using namespace Studio::Softer::Tests;
+
+namespace {
+	auto new_window() -> Windows::Window * {
+		auto window = new Windows::Window(Q_NULLPTR, Windows::ContentHost::ContentFactory());
+		window->setGeometry(100, 100, 800, 600);
+		window->setStateAnimationEnabled(true);
+		return window;
+	}
+}
+
+/**
+* \brief The transitions of the window states, run under the offscreen platform.
+* The overlay is moved on each tick of the animation timer, the window is laid out once at the end.
+*/
+class TestWindowStateAnimator : public QObject
+{
+	Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void frames();
+	void interrupted();
+	void maximize();
+};
+
+void TestWindowStateAnimator::initTestCase()
+{
+	QStandardPaths::setTestModeEnabled(true);
+}
+
+void TestWindowStateAnimator::frames()
+{
+	QWidget window;
+	window.setGeometry(100, 100, 400, 300);
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+	auto applied = 0;
+	Windows::WindowStateAnimator animator;
+	animator.setEnabled(true);
+	animator.setDuration(160);
+	animator.animate(&window, window.frameGeometry(), QRect(0, 0, 800, 600), [&applied]() { ++applied; });
+	QVERIFY(animator.isRunning());
+	QCOMPARE(applied, 0);
+
+	QTRY_VERIFY(!animator.isRunning());
+	QCOMPARE(applied, 1);
+	QCOMPARE(window.windowOpacity(), 1.0);
+
+	// 160 ms at one tick every 16 ms, a tick that came late is a dropped frame
+	QVERIFY(animator.frames() > 1);
+	QVERIFY(animator.frames() <= 12);
+	QVERIFY(animator.droppedFrames() >= 0);
+
+	auto &report = BenchmarkReport::instance();
+	report.setValue("stateAnimation.frames", animator.frames());
+	report.setValue("stateAnimation.droppedFrames", animator.droppedFrames());
+}
+
+// a transition that starts while another runs ends the previous one in its final state
+void TestWindowStateAnimator::interrupted()
+{
+	QWidget window;
+	window.show();
+	QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+	auto first = 0;
+	auto second = 0;
+	Windows::WindowStateAnimator animator;
+	animator.animate(&window, QRect(0, 0, 100, 100), QRect(0, 0, 200, 200), [&first]() { ++first; });
+	animator.animate(&window, QRect(0, 0, 200, 200), QRect(0, 0, 100, 100), [&second]() { ++second; });
+	QCOMPARE(first, 1);
+	QCOMPARE(second, 0);
+
+	QTRY_VERIFY(!animator.isRunning());
+	QCOMPARE(first, 1);
+	QCOMPARE(second, 1);
+}
+
+// the maximize button of the title bar, the window reaches its new state with a single layout pass
+void TestWindowStateAnimator::maximize()
+{
+	QScopedPointer<Windows::Window> window(new_window());
+	window->show();
+	QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+	QTRY_VERIFY(window->isContentReady());
+	QTest::qWait(50);
+
+	auto button = window->findChild<QWidget *>("maximizeButton");
+	QVERIFY(button);
+	auto layoutPasses = window->layoutPassCount();
+
+	QTest::mouseClick(button, Qt::LeftButton);
+	QVERIFY(window->stateAnimator().isRunning());
+	QVERIFY(!window->isMaximized());
+
+	QTRY_VERIFY(!window->stateAnimator().isRunning());
+	QTRY_VERIFY(window->isMaximized());
+	QTest::qWait(50);
+
+	QVERIFY(window->stateAnimator().frames() > 0);
+	QCOMPARE(window->layoutPassCount(), layoutPasses + 1);
+	BenchmarkReport::instance().setValue("stateAnimation.maximize.layoutPasses", window->layoutPassCount() - layoutPasses);
+}
+
+STUDIO_SOFTER_TEST_MAIN(TestWindowStateAnimator)
+
+#include "tst_WindowStateAnimator.moc"
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "CaptionButton.h"
+#include "IconCache.h"
+#include "ThemeEngine.h"
+
+#include <QPixmapCache>
+#include <QPainter>
+#include <QWindow>
+
+
+Studio::Softer::Windows::CaptionButton::CaptionButton(QWidget *parent)
+	: QAbstractButton(parent),
+	m_hoverColor(ThemeEngine::instance().styleColor("CaptionButton", "hover", "background-color", ThemeEngine::instance().color(ThemeEngine::CaptionHover))),
+	m_pressedColor(ThemeEngine::instance().styleColor("CaptionButton", "pressed", "background-color", ThemeEngine::instance().color(ThemeEngine::CaptionPressed)))
+{
+	setFocusPolicy(Qt::NoFocus);
+}
+
+
+/**
+* \brief Allows to set the icon from a file, decoded once for the process and rasterized by IconCache.
+* \param path The path of the file, ie: ":/Icons/IconsCommand/Close.png", empty to remove the icon.
+*/
+void Studio::Softer::Windows::CaptionButton::setIconPath(const QString& path)
+{
+	m_iconPath = path;
+	setIcon(path.isEmpty() ? QIcon() : IconCache::instance().icon(path));
+}
+
+
+QString Studio::Softer::Windows::CaptionButton::iconPath() const
+{
+	return m_iconPath;
+}
+
+
+/**
+* \brief Allows to set the colours of the theme behind the icon, the normal state is transparent.
+* \param hover The background of the hovered state.
+* \param pressed The background of the pressed state.
+*/
+void Studio::Softer::Windows::CaptionButton::setColors(const QColor& hover, const QColor& pressed)
+{
+	m_hoverColor = hover;
+	m_pressedColor = pressed;
+	update();
+}
+
+
+QColor Studio::Softer::Windows::CaptionButton::hoverColor() const
+{
+	return m_hoverColor;
+}
+
+
+QColor Studio::Softer::Windows::CaptionButton::pressedColor() const
+{
+	return m_pressedColor;
+}
+
+
+QSize Studio::Softer::Windows::CaptionButton::sizeHint() const
+{
+	auto margins = contentsMargins();
+	return iconSize() + QSize(margins.left() + margins.right(), margins.top() + margins.bottom());
+}
+
+
+/**
+* \brief Allows to get the picture of a state, rendered on its first use.
+* The pictures are shared by the buttons with the same icon, size, colours and pixel ratio.
+* \param state The state.
+* \return The picture, at the device pixel ratio of the screen of the window.
+*/
+QPixmap Studio::Softer::Windows::CaptionButton::statePixmap(State state) const
+{
+	auto handle = window()->windowHandle();
+	auto ratio = handle ? handle->devicePixelRatio() : devicePixelRatioF();
+	auto background = state == Hover ? m_hoverColor : state == Pressed ? m_pressedColor : QColor(Qt::transparent);
+
+	auto key = QString("caption:%1:%2x%3:%4x%5:%6:%7:%8")
+		.arg(icon().cacheKey())
+		.arg(width()).arg(height())
+		.arg(iconSize().width()).arg(iconSize().height())
+		.arg(contentsMargins().left())
+		.arg(background.rgba(), 0, 16)
+		.arg(ratio);
+
+	QPixmap pixmap;
+	if (QPixmapCache::find(key, &pixmap))
+		return pixmap;
+
+	pixmap = QPixmap(size() * ratio);
+	pixmap.setDevicePixelRatio(ratio);
+	pixmap.fill(background);
+
+	// centered in the contents, scaled down when larger than the icon size
+	auto iconPixmap = m_iconPath.isEmpty() ? icon().pixmap(handle, iconSize()) : IconCache::instance().pixmap(m_iconPath, iconSize(), ratio);
+	auto iconRect = QRect(QPoint(0, 0), iconPixmap.size() / iconPixmap.devicePixelRatio());
+	iconRect.moveCenter(contentsRect().center());
+
+	QPainter painter(&pixmap);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	painter.drawPixmap(iconRect, iconPixmap);
+	painter.end();
+
+	QPixmapCache::insert(key, pixmap);
+	return pixmap;
+}
+
+
+void Studio::Softer::Windows::CaptionButton::paintEvent(QPaintEvent* event)
+{
+	Q_UNUSED(event);
+	QPainter painter(this);
+	painter.drawPixmap(0, 0, statePixmap(current_state()));
+}
+
+
+void Studio::Softer::Windows::CaptionButton::enterEvent(QEvent* event)
+{
+	QAbstractButton::enterEvent(event);
+	update();
+}
+
+
+void Studio::Softer::Windows::CaptionButton::leaveEvent(QEvent* event)
+{
+	QAbstractButton::leaveEvent(event);
+	update();
+}
+
+
+auto Studio::Softer::Windows::CaptionButton::current_state() const -> State
+{
+	if (isDown()) return Pressed;
+	return underMouse() ? Hover : Normal;
+}
@@ -0,0 +1,59 @@
+#ifndef __CAPTIONBUTTON__H_
+#define __CAPTIONBUTTON__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QAbstractButton>
+#include <QColor>
+#include <QIcon>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief A button of the title bar, ie: minimize, maximize, restore and close.
+			* Its normal, hover and pressed states are rendered once into pixmaps at the
+			* device pixel ratio of the screen, shared through QPixmapCache by every button
+			* with the same icon, size and colours, and painted without the style.
+			* An icon given by its path is rasterized by IconCache, the colours are the ones of the current theme.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT CaptionButton : public QAbstractButton
+			{
+				Q_OBJECT
+			public:
+				enum State
+				{
+					Normal,
+					Hover,
+					Pressed
+				};
+
+				explicit CaptionButton(QWidget *parent = Q_NULLPTR);
+				void setIconPath(const QString &path);
+				QString iconPath() const;
+				void setColors(const QColor &hover, const QColor &pressed);
+				QColor hoverColor() const;
+				QColor pressedColor() const;
+				QSize sizeHint() const override;
+				QPixmap statePixmap(State state) const;
+
+			protected:
+				void paintEvent(QPaintEvent *event) override;
+				void enterEvent(QEvent *event) override;
+				void leaveEvent(QEvent *event) override;
+
+			private:
+				auto current_state() const -> State;
+
+				QString m_iconPath;
+				QColor m_hoverColor;
+				QColor m_pressedColor;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "ContentHost.h"
+
+#include <QApplication>
+#include <QResizeEvent>
+#include <QPainter>
+#include <QPointer>
+#include <QScreen>
+#include <QWindow>
+#include <QTimer>
+
+namespace {
+	auto record(Studio::Softer::Windows::FrameStats& stats, qint64 time) -> void {
+		++stats.frames;
+		stats.totalTime += time;
+		stats.maxTime = qMax(stats.maxTime, time);
+	}
+}
+
+Studio::Softer::Windows::ContentHost::ContentHost(QWidget *parent)
+	: QWidget(parent), m_content(Q_NULLPTR), m_frameTimer(new QTimer(this)), m_resizeStats{ 0, 0, 0 },
+	m_liveResizeStats{ 0, 0, 0 }, m_painted(false), m_liveResize(false)
+{
+	setObjectName("contentHost");
+	m_frameTimer->setSingleShot(true);
+	QObject::connect(m_frameTimer, &QTimer::timeout, this, [this]() { layout_content(); });
+	setAttribute(Qt::WA_OpaquePaintEvent);
+	setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+void Studio::Softer::Windows::ContentHost::setContent(QWidget* content)
+{
+	m_content = content;
+	m_content->setParent(this);
+	m_content->setGeometry(rect());
+	m_content->show();
+	updateGeometry();
+
+	if (m_contentReadyHandler) m_contentReadyHandler();
+}
+
+void Studio::Softer::Windows::ContentHost::setContentFactory(const ContentFactory& factory)
+{
+	m_factory = factory;
+}
+
+void Studio::Softer::Windows::ContentHost::setFirstPaintHandler(const std::function<void()>& handler)
+{
+	m_firstPaintHandler = handler;
+}
+
+void Studio::Softer::Windows::ContentHost::setContentReadyHandler(const std::function<void()>& handler)
+{
+	m_contentReadyHandler = handler;
+}
+
+QWidget* Studio::Softer::Windows::ContentHost::content() const
+{
+	return m_content;
+}
+
+QSize Studio::Softer::Windows::ContentHost::sizeHint() const
+{
+	return m_content ? m_content->sizeHint() : QWidget::sizeHint();
+}
+
+QSize Studio::Softer::Windows::ContentHost::minimumSizeHint() const
+{
+	return m_content ? m_content->minimumSizeHint().expandedTo(m_content->minimumSize()) : QWidget::minimumSizeHint();
+}
+
+void Studio::Softer::Windows::ContentHost::paintEvent(QPaintEvent* event)
+{
+	// placeholder, the content covers the host once created
+	QPainter painter(this);
+	if (m_frame.isNull())
+		painter.fillRect(event->rect(), palette().window());
+	else
+		painter.drawPixmap(rect(), m_frame);
+
+	if (!m_painted)
+	{
+		m_painted = true;
+		if (m_firstPaintHandler) m_firstPaintHandler();
+
+		// the shell is on the screen now, the content is created on the next iteration
+		if (!m_content && m_factory)
+			QTimer::singleShot(0, this, [this]() { create_content(); });
+	}
+}
+
+void Studio::Softer::Windows::ContentHost::resizeEvent(QResizeEvent* event)
+{
+	QWidget::resizeEvent(event);
+	if (!m_content) return;
+
+	if (!m_liveResize)
+	{
+		QElapsedTimer clock;
+		clock.start();
+		m_content->setGeometry(rect());
+		record(m_resizeStats, clock.nsecsElapsed() / 1000);
+		return;
+	}
+
+	// the content is replaced by a picture of itself until the resize ends
+	if (m_frame.isNull())
+	{
+		m_frame = m_content->grab();
+		m_focus = QApplication::focusWidget();
+		m_content->hide();
+	}
+
+	if (!m_frameTimer->isActive())
+		m_frameTimer->start(frame_interval());
+}
+
+// an interactive resize started, ie: WM_ENTERSIZEMOVE
+void Studio::Softer::Windows::ContentHost::beginLiveResize()
+{
+	m_liveResize = true;
+}
+
+// the interactive resize ended, the content is laid out once at its exact size
+void Studio::Softer::Windows::ContentHost::endLiveResize()
+{
+	if (!m_liveResize) return;
+
+	m_liveResize = false;
+	m_frameTimer->stop();
+	if (m_frame.isNull()) return;
+
+	QElapsedTimer clock;
+	clock.start();
+	m_content->setGeometry(rect());
+	m_content->show();
+	record(m_liveResizeStats, clock.nsecsElapsed() / 1000);
+
+	if (m_focus) m_focus->setFocus();
+	m_frame = QPixmap();
+}
+
+bool Studio::Softer::Windows::ContentHost::isLiveResizing() const
+{
+	return m_liveResize;
+}
+
+// layout times of the content following each resize, in microseconds
+const Studio::Softer::Windows::FrameStats& Studio::Softer::Windows::ContentHost::resizeStats() const
+{
+	return m_resizeStats;
+}
+
+// layout times of the content during the interactive resizes, in microseconds
+const Studio::Softer::Windows::FrameStats& Studio::Softer::Windows::ContentHost::liveResizeStats() const
+{
+	return m_liveResizeStats;
+}
+
+void Studio::Softer::Windows::ContentHost::resetStats()
+{
+	m_resizeStats = FrameStats{ 0, 0, 0 };
+	m_liveResizeStats = FrameStats{ 0, 0, 0 };
+}
+
+void Studio::Softer::Windows::ContentHost::create_content()
+{
+	if (m_content) return;
+	setContent(m_factory(this));
+}
+
+// one layout of the hidden content and a new picture of it, once per frame of the screen
+void Studio::Softer::Windows::ContentHost::layout_content()
+{
+	if (!m_content || m_frame.isNull()) return;
+
+	QElapsedTimer clock;
+	clock.start();
+	m_content->setGeometry(rect());
+	m_frame = m_content->grab();
+	record(m_liveResizeStats, clock.nsecsElapsed() / 1000);
+	update();
+}
+
+int Studio::Softer::Windows::ContentHost::frame_interval() const
+{
+	auto handle = window()->windowHandle();
+	auto refreshRate = handle && handle->screen() ? handle->screen()->refreshRate() : 60.0;
+	return qMax(1, qRound(1000.0 / (refreshRate > 0 ? refreshRate : 60.0)));
+}
@@ -0,0 +1,86 @@
+#ifndef __CONTENTHOST__H_
+#define __CONTENTHOST__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QElapsedTimer>
+#include <QPixmap>
+#include <QPointer>
+#include <QWidget>
+
+#include <functional>
+
+class QTimer;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief Frame time statistics of the content while the window is resized.
+			*/
+			struct FrameStats
+			{
+				int frames;
+				qint64 totalTime;
+				qint64 maxTime;
+
+				qreal averageTime() const { return frames ? qreal(totalTime) / frames : 0; }
+			};
+
+			/**
+			* \brief Holds the product content of a window, ie: the Designer.
+			* With a content factory, the host paints a flat placeholder first and
+			* creates the content on the next event loop iteration, once the window
+			* shell is on the screen.
+			* During an interactive resize the content is laid out at most once per frame of the
+			* screen, a stretched picture of its last layout is painted in between.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT ContentHost : public QWidget
+			{
+			public:
+				typedef std::function<QWidget *(QWidget *parent)> ContentFactory;
+
+				explicit ContentHost(QWidget *parent = Q_NULLPTR);
+				void setContent(QWidget *content);
+				void setContentFactory(const ContentFactory &factory);
+				void setFirstPaintHandler(const std::function<void()> &handler);
+				void setContentReadyHandler(const std::function<void()> &handler);
+				QWidget *content() const;
+				void beginLiveResize();
+				void endLiveResize();
+				bool isLiveResizing() const;
+				const FrameStats &resizeStats() const;
+				const FrameStats &liveResizeStats() const;
+				void resetStats();
+				QSize sizeHint() const override;
+				QSize minimumSizeHint() const override;
+
+			protected:
+				void paintEvent(QPaintEvent *event) override;
+				void resizeEvent(QResizeEvent *event) override;
+
+			private:
+				void create_content();
+				void layout_content();
+				int frame_interval() const;
+
+				std::function<void()> m_firstPaintHandler;
+				std::function<void()> m_contentReadyHandler;
+				ContentFactory m_factory;
+				QWidget *m_content;
+				QPixmap m_frame;
+				QPointer<QWidget> m_focus;
+				QTimer *m_frameTimer;
+				FrameStats m_resizeStats;
+				FrameStats m_liveResizeStats;
+				bool m_painted;
+				bool m_liveResize;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "HitTestMap.h"
+
+namespace {
+	auto scaled(const QRect& rect, qreal devicePixelRatio) -> QRect {
+		return QRect(qRound(rect.x() * devicePixelRatio), qRound(rect.y() * devicePixelRatio),
+			qRound(rect.width() * devicePixelRatio), qRound(rect.height() * devicePixelRatio));
+	}
+}
+
+
+Studio::Softer::Windows::HitTestMap::HitTestMap() :
+	m_borderWidth(8), m_resizeWidth(true), m_resizeHeight(true), m_valid(false)
+{
+}
+
+
+/**
+* \brief Allows to set the width of the resize borders.
+* \param borderWidth The width, in device pixels.
+*/
+void Studio::Softer::Windows::HitTestMap::setBorderWidth(int borderWidth)
+{
+	m_borderWidth = borderWidth;
+}
+
+
+/**
+* \brief Allows to get the width of the resize borders.
+* \return The width, in device pixels.
+*/
+int Studio::Softer::Windows::HitTestMap::borderWidth() const
+{
+	return m_borderWidth;
+}
+
+
+/**
+* \brief Allows to disable the resize borders, ie: for a fixed size or a maximized window.
+* \param horizontally True when the width of the window can change.
+* \param vertically True when the height of the window can change.
+*/
+void Studio::Softer::Windows::HitTestMap::setResizable(bool horizontally, bool vertically)
+{
+	m_resizeWidth = horizontally;
+	m_resizeHeight = vertically;
+}
+
+
+/**
+* \brief Allows to build the map for a window size and layout.
+* \param size The size of the window, in device independent pixels.
+* \param caption The area that moves the window, ie: the title bar.
+* \param exclusions The areas of the caption that are not part of it, ie: the buttons and the menu bar.
+* \param devicePixelRatio The ratio of the screen of the window.
+*/
+void Studio::Softer::Windows::HitTestMap::update(const QSize& size, const QRect& caption, const QVector<QRect>& exclusions, qreal devicePixelRatio)
+{
+	m_bounds = scaled(QRect(QPoint(0, 0), size), devicePixelRatio);
+	m_caption = scaled(caption, devicePixelRatio);
+
+	m_exclusions.clear();
+	m_exclusions.reserve(exclusions.size());
+	for (const auto &exclusion : exclusions)
+	{
+		if (exclusion.intersects(caption))
+			m_exclusions.append(scaled(exclusion, devicePixelRatio));
+	}
+
+	m_valid = true;
+}
+
+
+/**
+* \brief Allows to request a new build of the map, ie: after a resize or a layout change.
+*/
+void Studio::Softer::Windows::HitTestMap::invalidate()
+{
+	m_valid = false;
+}
+
+
+/**
+* \brief Allows to know if the map matches the window.
+* \return False when the map has to be built again.
+*/
+bool Studio::Softer::Windows::HitTestMap::isValid() const
+{
+	return m_valid;
+}
+
+
+/**
+* \brief Allows to get the region under a position.
+* \param position The position, in device pixels from the top left corner of the window.
+* \return The region, the corners have the priority over the borders and the borders over the caption.
+*/
+Studio::Softer::Windows::HitTestMap::Region Studio::Softer::Windows::HitTestMap::hitTest(const QPoint& position) const
+{
+	if (!m_bounds.contains(position))
+		return Client;
+
+	auto x = position.x();
+	auto y = position.y();
+
+	auto left = m_resizeWidth && x < m_bounds.left() + m_borderWidth;
+	auto right = m_resizeWidth && x > m_bounds.right() - m_borderWidth;
+	auto top = m_resizeHeight && y < m_bounds.top() + m_borderWidth;
+	auto bottom = m_resizeHeight && y > m_bounds.bottom() - m_borderWidth;
+
+	if (top) return left ? TopLeft : right ? TopRight : Top;
+	if (bottom) return left ? BottomLeft : right ? BottomRight : Bottom;
+	if (left) return Left;
+	if (right) return Right;
+
+	if (!m_caption.contains(position))
+		return Client;
+
+	for (const auto &exclusion : m_exclusions)
+	{
+		if (exclusion.contains(position))
+			return Client;
+	}
+
+	return Caption;
+}
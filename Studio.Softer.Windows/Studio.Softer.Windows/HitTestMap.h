@@ -0,0 +1,59 @@
+#ifndef __HITTESTMAP__H_
+#define __HITTESTMAP__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QVector>
+#include <QRect>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The regions of a frameless window, ie: the resize borders and the caption.
+			* The map is built once for a window size and layout, in device pixels, so that
+			* a hit test is a few rectangle tests without any call to the platform or to Qt.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT HitTestMap
+			{
+			public:
+				enum Region
+				{
+					Client,
+					Caption,
+					Left,
+					Right,
+					Top,
+					Bottom,
+					TopLeft,
+					TopRight,
+					BottomLeft,
+					BottomRight
+				};
+
+				HitTestMap();
+				void setBorderWidth(int borderWidth);
+				int borderWidth() const;
+				void setResizable(bool horizontally, bool vertically);
+				void update(const QSize &size, const QRect &caption, const QVector<QRect> &exclusions, qreal devicePixelRatio);
+				void invalidate();
+				bool isValid() const;
+				Region hitTest(const QPoint &position) const;
+
+			private:
+				QRect m_bounds;
+				QRect m_caption;
+				QVector<QRect> m_exclusions;
+				int m_borderWidth;
+				bool m_resizeWidth;
+				bool m_resizeHeight;
+				bool m_valid;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
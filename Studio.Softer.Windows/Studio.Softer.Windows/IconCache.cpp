@@ -0,0 +1,315 @@
+#include "IconCache.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QStyleOption>
+#include <QApplication>
+#include <QMutexLocker>
+#include <QImageReader>
+#include <QIconEngine>
+#include <QPainter>
+#include <QStyle>
+
+namespace {
+	const int defaultByteBudget = 4 * 1024 * 1024;
+
+	auto image_bytes(const QImage& image) -> int {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+		return static_cast<int>(image.sizeInBytes());
+#else
+		return image.byteCount();
+#endif
+	}
+
+	// all the images of a file, ie: the sizes of an .ico
+	auto decode(const QString& path) -> QVector<QImage> {
+		QVector<QImage> images;
+		QImageReader reader(path);
+		do
+		{
+			auto image = reader.read();
+			if (image.isNull()) break;
+			images.append(image);
+		} while (reader.jumpToNextImage());
+		return images;
+	}
+
+	// the smallest image at least as large as the size, or else the largest one
+	auto best_image(const QVector<QImage>& images, const QSize& size) -> QImage {
+		QImage best;
+		for (const auto &image : images)
+		{
+			auto large = image.width() >= size.width() && image.height() >= size.height();
+			auto bestLarge = !best.isNull() && best.width() >= size.width() && best.height() >= size.height();
+			auto area = image.width() * image.height();
+			auto bestArea = best.width() * best.height();
+			if (best.isNull() || (large && (!bestLarge || area < bestArea)) || (!large && !bestLarge && area > bestArea))
+				best = image;
+		}
+		return best;
+	}
+
+	/* An icon of a file of the cache, its pixmaps are rasterized by the cache when it is painted
+	* instead of converting all the images of the file when the icon is created.
+	*/
+	class CachedIconEngine : public QIconEngine
+	{
+	public:
+		explicit CachedIconEngine(const QString &path) : m_path(path) {}
+
+		void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state) override
+		{
+			Q_UNUSED(state);
+			auto devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+			auto picture = styled(Studio::Softer::Windows::IconCache::instance().pixmap(m_path, rect.size(), devicePixelRatio), mode);
+			if (picture.isNull()) return;
+
+			// the aspect ratio is kept, the picture is centered in the rectangle
+			QRect target(QPoint(), picture.size() / picture.devicePixelRatio());
+			target.moveCenter(rect.center());
+			painter->drawPixmap(target, picture);
+		}
+
+		// the size is in device pixels
+		QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state) override
+		{
+			Q_UNUSED(state);
+			return styled(Studio::Softer::Windows::IconCache::instance().pixmap(m_path, size, 1.0), mode);
+		}
+
+		QSize actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state) override
+		{
+			return pixmap(size, mode, state).size();
+		}
+
+		QList<QSize> availableSizes(QIcon::Mode mode, QIcon::State state) const override
+		{
+			Q_UNUSED(mode);
+			Q_UNUSED(state);
+			return Studio::Softer::Windows::IconCache::instance().sizes(m_path);
+		}
+
+		QString key() const override
+		{
+			return QStringLiteral("IconCache");
+		}
+
+		QIconEngine *clone() const override
+		{
+			return new CachedIconEngine(m_path);
+		}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+		void virtual_hook(int id, void *data) override
+		{
+			if (id == QIconEngine::IsNullHook)
+				*reinterpret_cast<bool *>(data) = availableSizes(QIcon::Normal, QIcon::Off).isEmpty();
+			else
+				QIconEngine::virtual_hook(id, data);
+		}
+#endif
+
+	private:
+		// the disabled and selected pictures are generated by the style, as the ones of QIcon
+		static QPixmap styled(const QPixmap &pixmap, QIcon::Mode mode)
+		{
+			if (mode == QIcon::Normal || pixmap.isNull() || !qApp)
+				return pixmap;
+			QStyleOption option(0);
+			option.palette = QApplication::palette();
+			return QApplication::style()->generatedIconPixmap(mode, pixmap, &option);
+		}
+
+		QString m_path;
+	};
+}
+
+
+Studio::Softer::Windows::IconCache::IconCache() :
+	m_images(defaultByteBudget), m_pixmaps(defaultByteBudget), m_hits(0), m_misses(0)
+{
+	// the pixmaps cannot outlive the GUI application
+	qAddPostRoutine([]() { IconCache::instance().clear(); });
+}
+
+
+Studio::Softer::Windows::IconCache::~IconCache()
+{
+	m_warming.waitForFinished();
+}
+
+
+/**
+* \brief Allows to get the process wide icon cache.
+* \return The icon cache.
+*/
+Studio::Softer::Windows::IconCache& Studio::Softer::Windows::IconCache::instance()
+{
+	static IconCache cache;
+	return cache;
+}
+
+
+/**
+* \brief Allows to decode icons on a worker thread, ie: while the splash screen is shown.
+* Only the images are decoded there, the pixmaps are created by the GUI thread on their first use.
+* \param paths The paths of the files, the small ones first since a request waits for the file being decoded.
+*/
+void Studio::Softer::Windows::IconCache::warmUp(const QStringList& paths)
+{
+	m_warming.waitForFinished();
+	m_warming = QtConcurrent::run([this, paths]()
+	{
+		for (const auto &path : paths)
+			images(path);
+	});
+}
+
+
+/**
+* \brief Allows to get an icon with all the images of a file.
+* Nothing is decoded nor converted here, the icon asks the cache for a pixmap of the size it is painted at,
+* so that the windows and the buttons using it share the same pictures.
+* \param path The path of the file.
+* \return The icon, null when the file cannot be read.
+*/
+QIcon Studio::Softer::Windows::IconCache::icon(const QString& path)
+{
+	return QIcon(new CachedIconEngine(path));
+}
+
+
+/**
+* \brief Allows to get the picture of an icon at a size and a device pixel ratio.
+* It is scaled down from the closest image of the file, and rasterized once for this size and ratio.
+* \param path The path of the file.
+* \param size The size, in device independent pixels.
+* \param devicePixelRatio The device pixel ratio of the screen.
+* \return The picture, null when the file cannot be read.
+*/
+QPixmap Studio::Softer::Windows::IconCache::pixmap(const QString& path, const QSize& size, qreal devicePixelRatio)
+{
+	auto key = QString("%1:%2x%3@%4").arg(path).arg(size.width()).arg(size.height()).arg(devicePixelRatio);
+	if (auto cached = m_pixmaps.object(key))
+	{
+		++m_hits;
+		return *cached;
+	}
+
+	++m_misses;
+	auto deviceSize = size * devicePixelRatio;
+	auto image = best_image(images(path), deviceSize);
+	if (image.isNull())
+		return QPixmap();
+
+	// the aspect ratio of the image is kept, ie: a 24x18 button of a square image
+	if (image.width() > deviceSize.width() || image.height() > deviceSize.height())
+		image = image.scaled(deviceSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+	auto pixmap = new QPixmap(QPixmap::fromImage(image));
+	pixmap->setDevicePixelRatio(devicePixelRatio);
+	auto result = *pixmap;
+	m_pixmaps.insert(key, pixmap, image_bytes(image));
+	return result;
+}
+
+
+/**
+* \brief Allows to get the sizes of the images of a file, ie: the sizes of an .ico.
+* \param path The path of the file.
+* \return The sizes, in pixels, empty when the file cannot be read.
+*/
+QList<QSize> Studio::Softer::Windows::IconCache::sizes(const QString& path)
+{
+	QList<QSize> sizes;
+	for (const auto &image : images(path))
+		sizes.append(image.size());
+	return sizes;
+}
+
+
+/**
+* \brief Allows to set the memory of the decoded images and the one of the rasterized pictures,
+* the least recently used ones are dropped above it.
+* \param bytes The budget of each, in bytes.
+*/
+void Studio::Softer::Windows::IconCache::setByteBudget(int bytes)
+{
+	{
+		QMutexLocker locker(&m_mutex);
+		m_images.setMaxCost(bytes);
+	}
+	m_pixmaps.setMaxCost(bytes);
+}
+
+
+int Studio::Softer::Windows::IconCache::byteBudget() const
+{
+	return m_pixmaps.maxCost();
+}
+
+
+/**
+* \brief Allows to release the decoded images and the rasterized pictures.
+*/
+void Studio::Softer::Windows::IconCache::clear()
+{
+	{
+		QMutexLocker locker(&m_mutex);
+		m_images.clear();
+	}
+	m_pixmaps.clear();
+}
+
+
+/**
+* \brief Allows to get the memory of the rasterized pictures.
+* \return The size, in bytes.
+*/
+int Studio::Softer::Windows::IconCache::bytes() const
+{
+	return m_pixmaps.totalCost();
+}
+
+
+/**
+* \brief Allows to get the memory of the decoded images.
+* \return The size, in bytes.
+*/
+int Studio::Softer::Windows::IconCache::decodedBytes()
+{
+	QMutexLocker locker(&m_mutex);
+	return m_images.totalCost();
+}
+
+
+/**
+* \brief Allows to get the number of icons and pictures served from the cache.
+* \return The number of hits.
+*/
+quint64 Studio::Softer::Windows::IconCache::hits() const
+{
+	return m_hits;
+}
+
+
+quint64 Studio::Softer::Windows::IconCache::misses() const
+{
+	return m_misses;
+}
+
+
+// the lock is held while decoding, a request for the file being warmed up waits for it instead of decoding it again
+// a file larger than the budget is decoded on each request
+QVector<QImage> Studio::Softer::Windows::IconCache::images(const QString& path)
+{
+	QMutexLocker locker(&m_mutex);
+	if (auto cached = m_images.object(path))
+		return *cached;
+
+	auto decoded = decode(path);
+	auto bytes = 0;
+	for (const auto &image : decoded)
+		bytes += image_bytes(image);
+	m_images.insert(path, new QVector<QImage>(decoded), bytes);
+	return decoded;
+}
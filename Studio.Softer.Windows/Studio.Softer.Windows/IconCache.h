@@ -0,0 +1,66 @@
+#ifndef __ICONCACHE__H_
+#define __ICONCACHE__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QStringList>
+#include <QFuture>
+#include <QPixmap>
+#include <QVector>
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QIcon>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The icons of the application, each file is decoded once and shared by the whole process.
+			* All the images of a file are decoded, ie: the sizes of an .ico, possibly in the background
+			* by warmUp while the splash screen is shown. The pixmaps of a size and a device pixel ratio
+			* are rasterized on their first use. The decoded images and the pixmaps are each kept under
+			* the budget of bytes, the least recently used ones are dropped above it.
+			* An icon reads its pixmaps from the cache when it is painted, it holds no picture of its own.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT IconCache
+			{
+			public:
+				static IconCache &instance();
+
+				void warmUp(const QStringList &paths);
+				QIcon icon(const QString &path);
+				QPixmap pixmap(const QString &path, const QSize &size, qreal devicePixelRatio);
+				QList<QSize> sizes(const QString &path);
+
+				void setByteBudget(int bytes);
+				int byteBudget() const;
+				void clear();
+				int bytes() const;
+				int decodedBytes();
+				quint64 hits() const;
+				quint64 misses() const;
+
+			private:
+				IconCache();
+				~IconCache();
+				IconCache(const IconCache &) = delete;
+				IconCache &operator=(const IconCache &) = delete;
+
+				QVector<QImage> images(const QString &path);
+
+				QMutex m_mutex;
+				QCache<QString, QVector<QImage>> m_images;
+				QFuture<void> m_warming;
+				QCache<QString, QPixmap> m_pixmaps;
+				quint64 m_hits;
+				quint64 m_misses;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
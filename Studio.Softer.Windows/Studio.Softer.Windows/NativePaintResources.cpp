@@ -0,0 +1,101 @@
+#include "NativePaintResources.h"
+
+QAtomicInt Studio::Softer::Windows::NativePaintResources::s_liveHandles;
+
+
+/**
+* \brief Allows to initialize the native resources with the functions of the platform.
+* \param createBrush The function that creates a solid brush.
+* \param destroyBrush The function that releases a brush.
+*/
+Studio::Softer::Windows::NativePaintResources::NativePaintResources(const CreateBrush& createBrush, const DestroyBrush& destroyBrush) :
+	m_createBrush(createBrush), m_destroyBrush(destroyBrush)
+{
+}
+
+
+Studio::Softer::Windows::NativePaintResources::~NativePaintResources()
+{
+	release();
+}
+
+
+/**
+* \brief Allows to get the brush of a colour, it is created on the first call.
+* \param color The colour, the alpha channel is ignored.
+* \return The native brush, null when it cannot be created.
+*/
+Studio::Softer::Windows::NativePaintResources::Handle Studio::Softer::Windows::NativePaintResources::brush(const QColor& color)
+{
+	auto rgb = color.rgb();
+
+	auto cached = m_brushes.constFind(rgb);
+	if (cached != m_brushes.constEnd())
+		return cached.value();
+
+	auto handle = m_createBrush(rgb);
+	if (!handle)
+		return Q_NULLPTR;
+
+	s_liveHandles.ref();
+	m_brushes.insert(rgb, handle);
+	return handle;
+}
+
+
+/**
+* \brief Allows to change the theme, the brushes of the previous theme are released.
+* The brushes in use must be replaced by the caller before the theme changes.
+* \param themeHash The hash of the theme, see StyleSheet::hash.
+*/
+void Studio::Softer::Windows::NativePaintResources::setTheme(const QByteArray& themeHash)
+{
+	if (themeHash == m_theme) return;
+
+	release();
+	m_theme = themeHash;
+}
+
+
+/**
+* \brief Allows to get the theme of the brushes.
+* \return The hash of the theme.
+*/
+QByteArray Studio::Softer::Windows::NativePaintResources::theme() const
+{
+	return m_theme;
+}
+
+
+/**
+* \brief Allows to release all the brushes.
+*/
+void Studio::Softer::Windows::NativePaintResources::release()
+{
+	for (auto handle : m_brushes)
+	{
+		m_destroyBrush(handle);
+		s_liveHandles.deref();
+	}
+	m_brushes.clear();
+}
+
+
+/**
+* \brief Allows to get the number of brushes of this cache.
+* \return The number of brushes.
+*/
+int Studio::Softer::Windows::NativePaintResources::brushCount() const
+{
+	return m_brushes.size();
+}
+
+
+/**
+* \brief Allows to get the number of native handles alive in the process, for debugging.
+* \return The number of handles created and not yet released.
+*/
+int Studio::Softer::Windows::NativePaintResources::liveHandles()
+{
+	return s_liveHandles.load();
+}
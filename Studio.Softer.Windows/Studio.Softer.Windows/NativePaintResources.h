@@ -0,0 +1,56 @@
+#ifndef __NATIVEPAINTRESOURCES__H_
+#define __NATIVEPAINTRESOURCES__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QAtomicInt>
+#include <QColor>
+#include <QHash>
+
+#include <functional>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The native brushes of the windows, one per colour of the theme.
+			* The brushes are created by an allocator, ie: CreateSolidBrush and DeleteObject,
+			* so that the accounting does not depend on the platform. They are released
+			* when the theme changes, the live handles are counted for the whole process.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT NativePaintResources
+			{
+			public:
+				typedef void *Handle;
+				typedef std::function<Handle(QRgb color)> CreateBrush;
+				typedef std::function<void(Handle handle)> DestroyBrush;
+
+				NativePaintResources(const CreateBrush &createBrush, const DestroyBrush &destroyBrush);
+				~NativePaintResources();
+				Handle brush(const QColor &color);
+				void setTheme(const QByteArray &themeHash);
+				QByteArray theme() const;
+				void release();
+				int brushCount() const;
+
+				static int liveHandles();
+
+			private:
+				NativePaintResources(const NativePaintResources &) = delete;
+				NativePaintResources &operator=(const NativePaintResources &) = delete;
+
+				CreateBrush m_createBrush;
+				DestroyBrush m_destroyBrush;
+				QHash<QRgb, Handle> m_brushes;
+				QByteArray m_theme;
+
+				static QAtomicInt s_liveHandles;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "ScreenGeometryCache.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
+
+
+Studio::Softer::Windows::ScreenGeometryCache::ScreenGeometryCache() :
+	m_window(Q_NULLPTR), m_provider([](QWindow *window, quintptr) { return screenGeometry(window); }),
+	m_geometry{ QRect(), QRect(), 1.0 }, m_screen(0), m_hits(0), m_misses(0), m_valid(false)
+{
+}
+
+
+/**
+* \brief Allows to follow the screens of a window, the cache is cleared when they change.
+* \param window The window, the connections live as long as it does.
+*/
+void Studio::Softer::Windows::ScreenGeometryCache::attach(QWindow* window)
+{
+	m_window = window;
+	invalidate();
+
+	for (auto screen : QGuiApplication::screens())
+		watch(screen);
+
+	QObject::connect(qApp, &QGuiApplication::screenAdded, window, [this](QScreen *screen)
+	{
+		watch(screen);
+		invalidate();
+	});
+	QObject::connect(qApp, &QGuiApplication::screenRemoved, window, [this]() { invalidate(); });
+	QObject::connect(window, &QWindow::screenChanged, window, [this]() { invalidate(); });
+}
+
+
+/**
+* \brief Allows to change how the geometry is read, ie: from the platform in device pixels.
+* \param provider The function called on a cache miss.
+*/
+void Studio::Softer::Windows::ScreenGeometryCache::setProvider(const Provider& provider)
+{
+	m_provider = provider;
+	invalidate();
+}
+
+
+/**
+* \brief Allows to get the geometry of the screen of the window.
+* \param screen The platform monitor the geometry is asked for, 0 for the screen of the window.
+* \return The cached geometry, read again after a screen change or for another monitor.
+*/
+const Studio::Softer::Windows::ScreenGeometry& Studio::Softer::Windows::ScreenGeometryCache::geometry(quintptr screen)
+{
+	if (m_valid && m_screen == screen)
+	{
+		++m_hits;
+		return m_geometry;
+	}
+
+	++m_misses;
+	m_geometry = m_provider(m_window, screen);
+	m_screen = screen;
+	m_valid = true;
+	return m_geometry;
+}
+
+
+/**
+* \brief Allows to clear the cache, the next call to geometry reads the screen again.
+*/
+void Studio::Softer::Windows::ScreenGeometryCache::invalidate()
+{
+	m_valid = false;
+}
+
+
+/**
+* \brief Allows to get the number of geometries served from the cache.
+* \return The number of hits.
+*/
+quint64 Studio::Softer::Windows::ScreenGeometryCache::hits() const
+{
+	return m_hits;
+}
+
+
+/**
+* \brief Allows to get the number of geometries read from the screen.
+* \return The number of misses.
+*/
+quint64 Studio::Softer::Windows::ScreenGeometryCache::misses() const
+{
+	return m_misses;
+}
+
+
+/**
+* \brief Allows to read the geometry of the screen of a window from Qt, in device independent pixels.
+* \param window The window.
+* \return The geometry, empty when the window has no screen.
+*/
+Studio::Softer::Windows::ScreenGeometry Studio::Softer::Windows::ScreenGeometryCache::screenGeometry(QWindow* window)
+{
+	auto screen = window ? window->screen() : QGuiApplication::primaryScreen();
+	if (!screen)
+		return ScreenGeometry{ QRect(), QRect(), 1.0 };
+
+	return ScreenGeometry{ screen->availableGeometry(), screen->geometry(), screen->devicePixelRatio() };
+}
+
+
+void Studio::Softer::Windows::ScreenGeometryCache::watch(QScreen* screen)
+{
+	auto invalidate = [this]() { m_valid = false; };
+	QObject::connect(screen, &QScreen::geometryChanged, m_window, invalidate);
+	QObject::connect(screen, &QScreen::availableGeometryChanged, m_window, invalidate);
+	QObject::connect(screen, &QScreen::logicalDotsPerInchChanged, m_window, invalidate);
+	QObject::connect(screen, &QScreen::physicalDotsPerInchChanged, m_window, invalidate);
+}
@@ -0,0 +1,66 @@
+#ifndef __SCREENGEOMETRYCACHE__H_
+#define __SCREENGEOMETRYCACHE__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QRect>
+
+#include <functional>
+
+class QWindow;
+class QScreen;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The geometry of the screen of a window.
+			*/
+			struct ScreenGeometry
+			{
+				QRect workArea;
+				QRect screenRect;
+				qreal devicePixelRatio;
+			};
+
+			/**
+			* \brief Keeps the geometry of the screen of a window between two screen changes.
+			* The maximize and min/max messages come in bursts during a drag, they are served
+			* from the cache until a screen is added, removed, moved, resized or changes its DPI.
+			* The platform sends them before Qt reports a new screen, so the caller names the monitor
+			* it asks for, ie: an HMONITOR, and another monitor than the cached one is a miss.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT ScreenGeometryCache
+			{
+			public:
+				typedef std::function<ScreenGeometry(QWindow *window, quintptr screen)> Provider;
+
+				ScreenGeometryCache();
+				void attach(QWindow *window);
+				void setProvider(const Provider &provider);
+				const ScreenGeometry &geometry(quintptr screen = 0);
+				void invalidate();
+				quint64 hits() const;
+				quint64 misses() const;
+
+				static ScreenGeometry screenGeometry(QWindow *window);
+
+			private:
+				void watch(QScreen *screen);
+
+				QWindow *m_window;
+				Provider m_provider;
+				ScreenGeometry m_geometry;
+				quintptr m_screen;
+				quint64 m_hits;
+				quint64 m_misses;
+				bool m_valid;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
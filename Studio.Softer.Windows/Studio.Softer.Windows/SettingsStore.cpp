@@ -0,0 +1,234 @@
+#include "SettingsStore.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSettings>
+#include <QFileInfo>
+#include <QTimer>
+#include <QFile>
+#include <QDir>
+
+namespace {
+	const quint32 storeMagic = 0x53535354; // "SSST"
+	const quint16 storeVersion = 1;
+	const int flushDelay = 1000; // milliseconds
+
+	// the keys written by the previous versions with QSettings
+	const char *const legacyKeys[] = { "Window/Geometry", "Window/WindowState", "Window/WindowState/maximized" };
+
+	QMutex writeMutex;
+	quint64 writtenRevision = 0;
+
+	auto read_file(const QString& path, const QString& orgName, const QString& appName) -> QVariantMap {
+		QVariantMap values;
+
+		QFile file(path);
+		if (file.open(QIODevice::ReadOnly)) {
+			QDataStream stream(&file);
+			stream.setVersion(QDataStream::Qt_5_6);
+
+			quint32 magic = 0;
+			quint16 version = 0;
+			stream >> magic >> version;
+			if (magic == storeMagic && version == storeVersion) {
+				stream >> values;
+				if (stream.status() == QDataStream::Ok)
+					return values;
+			}
+			values.clear();
+		}
+
+		// first launch with the store, the values are taken from QSettings
+		QSettings settings(orgName, appName);
+		for (auto key : legacyKeys) {
+			if (settings.contains(key))
+				values.insert(key, settings.value(key));
+		}
+		return values;
+	}
+
+	auto write_file(const QString& path, const QVariantMap& values, quint64 revision) -> void {
+		QMutexLocker locker(&writeMutex);
+
+		// a more recent snapshot was already written
+		if (revision <= writtenRevision) return;
+
+		QDir().mkpath(QFileInfo(path).absolutePath());
+		QSaveFile file(path);
+		if (!file.open(QIODevice::WriteOnly)) {
+			qWarning("Cannot write the settings to %s", qPrintable(path));
+			return;
+		}
+
+		QDataStream stream(&file);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << storeMagic << storeVersion << values;
+
+		// the file replaces the previous one by a rename, only when fully written
+		if (file.commit())
+			writtenRevision = revision;
+	}
+}
+
+
+/**
+* \brief Allows to get the process wide settings store.
+* \return The settings store.
+*/
+Studio::Softer::Windows::SettingsStore& Studio::Softer::Windows::SettingsStore::instance()
+{
+	static SettingsStore store;
+	return store;
+}
+
+
+Studio::Softer::Windows::SettingsStore::SettingsStore() :
+	m_flushTimer(Q_NULLPTR), m_revision(0), m_flushedRevision(0), m_loading(false), m_loaded(false)
+{
+}
+
+
+Studio::Softer::Windows::SettingsStore::~SettingsStore()
+{
+	delete m_flushTimer;
+}
+
+
+/**
+* \brief Allows to start reading the settings of an application in the background.
+* \param orgName The organization name, ie: StudioSofter.
+* \param appName The application name, ie: Designer Studio.
+*/
+void Studio::Softer::Windows::SettingsStore::load(const QString& orgName, const QString& appName)
+{
+	if (m_loaded || m_loading) return;
+
+	m_orgName = orgName;
+	m_appName = appName;
+	m_loading = true;
+	m_pendingValues = QtConcurrent::run(read_file, filePath(), orgName, appName);
+}
+
+
+/**
+* \brief Allows to know if a value is stored.
+* \param key The key, ie: Window/Geometry.
+* \return True when the key has a value.
+*/
+bool Studio::Softer::Windows::SettingsStore::contains(const QString& key)
+{
+	ensure_loaded();
+	return m_values.contains(key);
+}
+
+
+/**
+* \brief Allows to read a value from memory.
+* The first read waits for the background load when it is not finished.
+* \param key The key, ie: Window/Geometry.
+* \param defaultValue The value returned when the key has no value.
+* \return The value.
+*/
+QVariant Studio::Softer::Windows::SettingsStore::value(const QString& key, const QVariant& defaultValue)
+{
+	ensure_loaded();
+	return m_values.value(key, defaultValue);
+}
+
+
+/**
+* \brief Allows to change a value, the file is written a moment later with the other changes.
+* \param key The key, ie: Window/Geometry.
+* \param value The new value.
+*/
+void Studio::Softer::Windows::SettingsStore::setValue(const QString& key, const QVariant& value)
+{
+	ensure_loaded();
+
+	auto current = m_values.constFind(key);
+	if (current != m_values.constEnd() && current.value() == value) return;
+
+	m_values.insert(key, value);
+	schedule_flush();
+}
+
+
+/**
+* \brief Allows to remove a value.
+* \param key The key, ie: Window/Geometry.
+*/
+void Studio::Softer::Windows::SettingsStore::remove(const QString& key)
+{
+	ensure_loaded();
+	if (m_values.remove(key)) schedule_flush();
+}
+
+
+/**
+* \brief Allows to write the pending changes now, from a background thread.
+*/
+void Studio::Softer::Windows::SettingsStore::flush()
+{
+	if (m_flushTimer) m_flushTimer->stop();
+	if (m_revision == m_flushedRevision) return;
+
+	m_flushedRevision = m_revision;
+	m_flushing = QtConcurrent::run(write_file, filePath(), m_values, m_revision);
+}
+
+
+/**
+* \brief Allows to write the pending changes and to wait for the file, ie: before the process exits.
+*/
+void Studio::Softer::Windows::SettingsStore::sync()
+{
+	flush();
+	m_flushing.waitForFinished();
+}
+
+
+/**
+* \brief Allows to get the file of the settings.
+* \return The path of the file, in the configuration directory of the user.
+*/
+QString Studio::Softer::Windows::SettingsStore::filePath() const
+{
+	return QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation)
+		+ QLatin1Char('/') + m_orgName + QLatin1Char('/') + m_appName + QLatin1String(".state");
+}
+
+
+void Studio::Softer::Windows::SettingsStore::ensure_loaded()
+{
+	if (m_loaded) return;
+
+	// nobody started the load, the application names are used
+	if (!m_loading)
+		load(QCoreApplication::organizationName(), QCoreApplication::applicationName());
+
+	m_values = m_pendingValues.result();
+	m_pendingValues = QFuture<QVariantMap>();
+	m_loading = false;
+	m_loaded = true;
+}
+
+
+void Studio::Softer::Windows::SettingsStore::schedule_flush()
+{
+	++m_revision;
+
+	if (!m_flushTimer)
+	{
+		m_flushTimer = new QTimer;
+		m_flushTimer->setSingleShot(true);
+		m_flushTimer->setInterval(flushDelay);
+		QObject::connect(m_flushTimer, &QTimer::timeout, [this]() { flush(); });
+	}
+
+	// the writes of the next second are coalesced in one file
+	m_flushTimer->start();
+}
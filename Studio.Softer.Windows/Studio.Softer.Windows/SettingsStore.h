@@ -0,0 +1,62 @@
+#ifndef __SETTINGSSTORE__H_
+#define __SETTINGSSTORE__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QVariantMap>
+#include <QFuture>
+#include <QString>
+
+class QTimer;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The persisted state of the application, ie: the window geometry.
+			* The file is read once in the background, the values are then served from memory.
+			* The writes are coalesced and flushed from a background thread, the file is
+			* replaced atomically so that a crash never leaves it half written.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT SettingsStore
+			{
+			public:
+				static SettingsStore &instance();
+
+				void load(const QString &orgName, const QString &appName);
+				bool contains(const QString &key);
+				QVariant value(const QString &key, const QVariant &defaultValue = QVariant());
+				void setValue(const QString &key, const QVariant &value);
+				void remove(const QString &key);
+				void flush();
+				void sync();
+				QString filePath() const;
+
+			private:
+				SettingsStore();
+				~SettingsStore();
+				SettingsStore(const SettingsStore &) = delete;
+				SettingsStore &operator=(const SettingsStore &) = delete;
+
+				void ensure_loaded();
+				void schedule_flush();
+
+				QVariantMap m_values;
+				QFuture<QVariantMap> m_pendingValues;
+				QFuture<void> m_flushing;
+				QString m_orgName;
+				QString m_appName;
+				QTimer *m_flushTimer;
+				quint64 m_revision;
+				quint64 m_flushedRevision;
+				bool m_loading;
+				bool m_loaded;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,507 @@
+#include "StyleSheet.h"
+#include "StyleTables.h"
+
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QRegExp>
+#include <QFile>
+#include <QDir>
+
+namespace {
+	const quint32 cacheMagic = 0x51535343; // "QSSC"
+	const quint16 cacheVersion = 1;
+
+	// the least recently written files are removed beyond this number
+	const int cacheLimit = 16;
+
+	// the smallest serialized rule and declaration, three or two empty strings and a count
+	const int minimumRuleSize = 16;
+	const int minimumDeclarationSize = 8;
+	const quint32 maximumCount = 1 << 20;
+
+	/* The size and the time of the last change of a source, its content hash when it has no time.
+	* A warm start compares it to the one of the cache without reading the source.
+	*/
+	auto source_stamp(const QFileInfo& info) -> QByteArray {
+		auto modified = info.lastModified();
+		if (modified.isValid())
+			return QByteArray::number(info.size()) + '-' + QByteArray::number(modified.toMSecsSinceEpoch());
+
+		QFile file(info.filePath());
+		return file.open(QFile::ReadOnly) ? Studio::Softer::Windows::StyleSheet::hashOf(file.readAll()) : QByteArray();
+	}
+
+	/* A count read from a cache file is trusted only when the rest of the file can hold that many items,
+	* so that a corrupted file cannot make the reader allocate without bounds.
+	*/
+	auto read_count(QDataStream& stream, int minimumItemSize) -> int {
+		quint32 count = 0;
+		stream >> count;
+
+		auto device = stream.device();
+		auto available = device ? device->bytesAvailable() : 0;
+		if (stream.status() != QDataStream::Ok || count > maximumCount || count > available / minimumItemSize)
+		{
+			stream.setStatus(QDataStream::ReadCorruptData);
+			return 0;
+		}
+		return static_cast<int>(count);
+	}
+
+	auto evict_cache(const QString& directory) -> void {
+		auto files = QDir(directory).entryInfoList(QStringList() << QStringLiteral("*.qssc"), QDir::Files, QDir::Time);
+		for (auto i = cacheLimit; i < files.size(); ++i)
+			QFile::remove(files[i].absoluteFilePath());
+	}
+
+	auto strip_comments(const QString& source) -> QString {
+		QString result;
+		result.reserve(source.size());
+
+		auto position = 0;
+		while (position < source.size()) {
+			auto start = source.indexOf(QLatin1String("/*"), position);
+			if (start < 0) {
+				result += source.midRef(position);
+				break;
+			}
+			result += source.midRef(position, start - position);
+			auto end = source.indexOf(QLatin1String("*/"), start + 2);
+			position = (end < 0) ? source.size() : end + 2;
+		}
+		return result;
+	}
+
+	/* Replaces the uses of the variables in a text, ie: "background: @panel.background".
+	* An unknown variable is kept as it is.
+	*/
+	auto substitute(const QString& text, const QHash<QString, QString>& values) -> QString {
+		QRegExp reference("@([A-Za-z_][\\w.-]*)");
+		QString result;
+		auto position = 0;
+		for (auto index = reference.indexIn(text); index >= 0; index = reference.indexIn(text, position))
+		{
+			result += text.midRef(position, index - position);
+			result += values.contains(reference.cap(1)) ? values.value(reference.cap(1)) : reference.cap(0);
+			position = index + reference.matchedLength();
+		}
+		result += text.midRef(position);
+		return result;
+	}
+
+	/* Removes the definitions of the variables, ie: "@panel.background: #383838;" outside of the rules,
+	* and replaces their uses. A definition may use the variables defined before it, and hides a variable
+	* given by the caller.
+	*/
+	auto expand_variables(const QString& source, const QHash<QString, QString>& variables) -> QString {
+		auto values = variables;
+		QString result;
+		result.reserve(source.size());
+
+		auto depth = 0;
+		for (auto position = 0; position < source.size(); ++position)
+		{
+			if (source[position] == QLatin1Char('{')) ++depth;
+			else if (source[position] == QLatin1Char('}')) depth = qMax(0, depth - 1);
+
+			if (depth == 0 && source[position] == QLatin1Char('@'))
+			{
+				auto end = source.indexOf(QLatin1Char(';'), position);
+				if (end < 0) end = source.size();
+				auto definition = source.mid(position + 1, end - position - 1);
+				auto colon = definition.indexOf(QLatin1Char(':'));
+				if (colon > 0)
+					values.insert(definition.left(colon).trimmed(), substitute(definition.mid(colon + 1).simplified(), values));
+				position = end;
+				continue;
+			}
+			result += source[position];
+		}
+		return substitute(result, values);
+	}
+
+	// the variables in the order of their names, so that the same values always give the same hash
+	auto variables_text(const QHash<QString, QString>& variables) -> QByteArray {
+		auto names = variables.keys();
+		names.sort();
+		QByteArray text;
+		for (const auto &name : names)
+			text += name.toUtf8() + ':' + variables.value(name).toUtf8() + ';';
+		return text;
+	}
+
+	/* Splits the subject of a selector (its last compound selector) into
+	* the objectName and the class name, without pseudo-states, sub-controls and attributes.
+	* "QMenuBar::item:selected" gives ("", "QMenuBar"), "#toolBar::separator" gives ("toolBar", "").
+	*/
+	auto split_subject(const QString& selector, QString& objectName, QString& className) -> void {
+		auto compounds = selector.split(QRegExp("[\\s>]+"), QString::SkipEmptyParts);
+		auto subject = compounds.isEmpty() ? QString() : compounds.last();
+
+		auto end = subject.size();
+		for (auto i = 0; i < subject.size(); ++i) {
+			if (subject[i] == QLatin1Char(':') || subject[i] == QLatin1Char('[')) {
+				end = i;
+				break;
+			}
+		}
+		subject.truncate(end);
+		if (subject.startsWith(QLatin1Char('.'))) subject.remove(0, 1);
+
+		auto hash = subject.indexOf(QLatin1Char('#'));
+		if (hash < 0) {
+			className = subject;
+			objectName.clear();
+		}
+		else {
+			className = subject.left(hash);
+			objectName = subject.mid(hash + 1);
+		}
+	}
+}
+
+
+Studio::Softer::Windows::StyleSheet::StyleSheet() :
+	m_fromCache(false)
+{
+}
+
+
+/**
+* \brief Allows to parse a stylesheet into indexed rules.
+* The variables of the stylesheet, ie: "@panel.background: #383838;", are replaced by their values.
+* \param source The content of a .qss file.
+* \param variables The values of the variables the source does not define, ie: the tokens of a theme.
+* \return The compiled stylesheet.
+*/
+Studio::Softer::Windows::StyleSheet Studio::Softer::Windows::StyleSheet::compile(const QByteArray& source, const QHash<QString, QString>& variables)
+{
+	StyleSheet styleSheet;
+	styleSheet.m_hash = hashOf(source, variables);
+
+	auto text = expand_variables(strip_comments(QString::fromUtf8(source)), variables);
+	auto position = 0;
+	while (position < text.size())
+	{
+		auto open = text.indexOf(QLatin1Char('{'), position);
+		if (open < 0) break;
+		auto close = text.indexOf(QLatin1Char('}'), open + 1);
+		if (close < 0) break;
+
+		QVector<StyleDeclaration> declarations;
+		for (const auto &declaration : text.mid(open + 1, close - open - 1).split(QLatin1Char(';')))
+		{
+			// the value may contain colons, ie: url(:/Icons/...)
+			auto colon = declaration.indexOf(QLatin1Char(':'));
+			if (colon < 0) continue;
+			auto name = declaration.left(colon).trimmed();
+			auto value = declaration.mid(colon + 1).simplified();
+			if (!name.isEmpty()) declarations.append(qMakePair(name, value));
+		}
+
+		for (const auto &selector : text.mid(position, open - position).split(QLatin1Char(',')))
+		{
+			StyleRule rule;
+			rule.selector = selector.simplified();
+			if (rule.selector.isEmpty()) continue;
+			split_subject(rule.selector, rule.objectName, rule.className);
+			rule.declarations = declarations;
+			styleSheet.m_rules.append(rule);
+		}
+
+		position = close + 1;
+	}
+
+	// canonical text handed to Qt, without comments and redundant whitespaces.
+	for (const auto &rule : styleSheet.m_rules)
+	{
+		styleSheet.m_text += rule.selector + QLatin1Char('{');
+		for (const auto &declaration : rule.declarations)
+			styleSheet.m_text += declaration.first + QLatin1Char(':') + declaration.second + QLatin1Char(';');
+		styleSheet.m_text += QLatin1Char('}');
+	}
+
+	styleSheet.buildIndex();
+	return styleSheet;
+}
+
+
+/**
+* \brief Allows to load a stylesheet, from the disk cache when the source did not change.
+* The cache is found by the path of the source and checked against its size and time of change,
+* so that a warm start neither reads, hashes nor parses the source. Each set of variables has its own cache.
+* \param path The path of the .qss file, resources paths are allowed.
+* \param variables The values of the variables the source does not define, ie: the tokens of a theme.
+* \return The compiled stylesheet, empty if the file cannot be read.
+*/
+Studio::Softer::Windows::StyleSheet Studio::Softer::Windows::StyleSheet::load(const QString& path, const QHash<QString, QString>& variables)
+{
+	QFileInfo info(path);
+	if (!info.isFile())
+		return StyleSheet();
+
+	//Warm start, the parsed form of this version of the source is already on the disk.
+	auto stamp = source_stamp(info);
+	auto key = info.absoluteFilePath();
+	if (!variables.isEmpty())
+		key += QLatin1Char('#') + QString::fromLatin1(QCryptographicHash::hash(variables_text(variables), QCryptographicHash::Sha1).toHex());
+	QFile cache(cachePath(key));
+	if (cache.open(QFile::ReadOnly))
+	{
+		QByteArray cachedStamp;
+		QDataStream stream(&cache);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream >> cachedStamp;
+		if (stream.status() == QDataStream::Ok && cachedStamp == stamp)
+		{
+			StyleSheet styleSheet;
+			stream >> styleSheet;
+			if (stream.status() == QDataStream::Ok)
+			{
+				styleSheet.m_fromCache = true;
+				styleSheet.buildIndex();
+				return styleSheet;
+			}
+		}
+		cache.close();
+	}
+
+	QFile file(path);
+	if (!file.open(QFile::ReadOnly))
+		return StyleSheet();
+
+	auto styleSheet = compile(file.readAll(), variables);
+
+	auto directory = QFileInfo(cache.fileName()).absolutePath();
+	QDir().mkpath(directory);
+	QSaveFile output(cache.fileName());
+	if (output.open(QIODevice::WriteOnly))
+	{
+		QDataStream stream(&output);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << stamp << styleSheet;
+		if (output.commit())
+			evict_cache(directory);
+	}
+
+	return styleSheet;
+}
+
+
+/**
+* \brief Allows to get a stylesheet from the tables compiled at build time, without parsing nor disk cache.
+* The tables keep the variables the source does not define, they are replaced by the given values.
+* \param table The table of a generated header, ie: Studio::Softer::Styles::Style::table.
+* \param variables The values of the variables, ie: the tokens of a theme.
+* \return The stylesheet, with the same hash as the source compiled with these variables.
+*/
+Studio::Softer::Windows::StyleSheet Studio::Softer::Windows::StyleSheet::fromTable(const StyleTables::Table& table, const QHash<QString, QString>& variables)
+{
+	StyleSheet styleSheet;
+	styleSheet.m_hash = QByteArray::fromHex(table.hash);
+	if (!variables.isEmpty())
+		styleSheet.m_hash = QCryptographicHash::hash(styleSheet.m_hash + variables_text(variables), QCryptographicHash::Sha1);
+	styleSheet.m_text = substitute(QString::fromUtf8(table.text), variables);
+	styleSheet.m_rules.reserve(table.ruleCount);
+	for (auto i = 0; i < table.ruleCount; ++i)
+	{
+		const auto &source = table.rules[i];
+		StyleRule rule;
+		rule.selector = QString::fromUtf8(source.selector);
+		rule.objectName = QString::fromUtf8(source.objectName);
+		rule.className = QString::fromUtf8(source.className);
+		rule.declarations.reserve(source.declarationCount);
+		for (auto j = source.firstDeclaration; j < source.firstDeclaration + source.declarationCount; ++j)
+			rule.declarations.append(qMakePair(QString::fromUtf8(table.declarations[j].property), substitute(QString::fromUtf8(table.declarations[j].value), variables)));
+		styleSheet.m_rules.append(rule);
+	}
+	styleSheet.buildIndex();
+	return styleSheet;
+}
+
+
+/**
+* \brief Allows to get the content hash used as the cache key.
+* \param source The content of a .qss file.
+* \param variables The values of the variables the source does not define.
+* \return The SHA-1 hash of the source, then of this hash and the variables when there are some.
+*/
+QByteArray Studio::Softer::Windows::StyleSheet::hashOf(const QByteArray& source, const QHash<QString, QString>& variables)
+{
+	auto hash = QCryptographicHash::hash(source, QCryptographicHash::Sha1);
+	if (variables.isEmpty())
+		return hash;
+	return QCryptographicHash::hash(hash + variables_text(variables), QCryptographicHash::Sha1);
+}
+
+
+bool Studio::Softer::Windows::StyleSheet::isEmpty() const
+{
+	return m_rules.isEmpty();
+}
+
+
+bool Studio::Softer::Windows::StyleSheet::isFromCache() const
+{
+	return m_fromCache;
+}
+
+
+QByteArray Studio::Softer::Windows::StyleSheet::hash() const
+{
+	return m_hash;
+}
+
+
+/**
+* \brief Allows to get the stylesheet text to give to QApplication::setStyleSheet.
+* \return The canonical text of the rules.
+*/
+QString Studio::Softer::Windows::StyleSheet::text() const
+{
+	return m_text;
+}
+
+
+const QVector<Studio::Softer::Windows::StyleRule>& Studio::Softer::Windows::StyleSheet::rules() const
+{
+	return m_rules;
+}
+
+
+/**
+* \brief Allows to get the rules whose subject is an objectName, ie: #windowTitleBar.
+* \param objectName The objectName of a widget.
+* \return The matching rules, in the stylesheet order.
+*/
+QVector<const Studio::Softer::Windows::StyleRule*> Studio::Softer::Windows::StyleSheet::rulesForObjectName(const QString& objectName) const
+{
+	QVector<const StyleRule *> result;
+	for (auto index : m_byObjectName.value(objectName))
+		result.append(&m_rules[index]);
+	return result;
+}
+
+
+/**
+* \brief Allows to get the rules whose subject is a class without objectName, ie: QMenuBar::item.
+* \param className The class name of a widget.
+* \return The matching rules, in the stylesheet order.
+*/
+QVector<const Studio::Softer::Windows::StyleRule*> Studio::Softer::Windows::StyleSheet::rulesForClass(const QString& className) const
+{
+	QVector<const StyleRule *> result;
+	for (auto index : m_byClass.value(className))
+		result.append(&m_rules[index]);
+	return result;
+}
+
+
+/**
+* \brief Allows to get the declarations of a selector, ie: QMenuBar::item:selected.
+* \param selector The selector, without redundant whitespaces.
+* \return The declarations of all its rules, in the stylesheet order.
+*/
+QVector<Studio::Softer::Windows::StyleDeclaration> Studio::Softer::Windows::StyleSheet::declarations(const QString& selector) const
+{
+	QVector<StyleDeclaration> result;
+	for (auto index : m_bySelector.value(selector))
+		result += m_rules[index].declarations;
+	return result;
+}
+
+
+/**
+* \brief Allows to compare two versions of a stylesheet by selector.
+* \param from The previous version.
+* \param to The new version.
+* \return The selectors added, removed or whose declarations changed, in the order of the new version.
+*/
+QStringList Studio::Softer::Windows::StyleSheet::changedSelectors(const StyleSheet& from, const StyleSheet& to)
+{
+	QStringList result;
+	for (const auto &rule : to.m_rules)
+	{
+		if (!result.contains(rule.selector) && from.declarations(rule.selector) != to.declarations(rule.selector))
+			result.append(rule.selector);
+	}
+	for (const auto &rule : from.m_rules)
+	{
+		if (!to.m_bySelector.contains(rule.selector) && !result.contains(rule.selector))
+			result.append(rule.selector);
+	}
+	return result;
+}
+
+
+void Studio::Softer::Windows::StyleSheet::buildIndex()
+{
+	m_byObjectName.clear();
+	m_byClass.clear();
+	m_bySelector.clear();
+
+	for (auto i = 0; i < m_rules.size(); ++i)
+	{
+		m_bySelector[m_rules[i].selector].append(i);
+		if (!m_rules[i].objectName.isEmpty())
+			m_byObjectName[m_rules[i].objectName].append(i);
+		else
+			m_byClass[m_rules[i].className].append(i);
+	}
+}
+
+
+// one file per source, named by the hash of its path
+QString Studio::Softer::Windows::StyleSheet::cachePath(const QString& sourcePath)
+{
+	auto key = QCryptographicHash::hash(sourcePath.toUtf8(), QCryptographicHash::Sha1);
+	return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+		+ QLatin1String("/StudioSofter/themes/") + QString::fromLatin1(key.toHex()) + QLatin1String(".qssc");
+}
+
+
+QDataStream& Studio::Softer::Windows::operator<<(QDataStream& stream, const StyleSheet& styleSheet)
+{
+	stream << cacheMagic << cacheVersion << styleSheet.m_hash << styleSheet.m_text;
+	stream << static_cast<quint32>(styleSheet.m_rules.size());
+	for (const auto &rule : styleSheet.m_rules)
+		stream << rule.selector << rule.objectName << rule.className << rule.declarations;
+	return stream;
+}
+
+
+QDataStream& Studio::Softer::Windows::operator>>(QDataStream& stream, StyleSheet& styleSheet)
+{
+	quint32 magic = 0;
+	quint16 version = 0;
+	stream >> magic >> version;
+	if (magic != cacheMagic || version != cacheVersion)
+	{
+		stream.setStatus(QDataStream::ReadCorruptData);
+		return stream;
+	}
+
+	stream >> styleSheet.m_hash >> styleSheet.m_text;
+	auto count = read_count(stream, minimumRuleSize);
+	styleSheet.m_rules.clear();
+	styleSheet.m_rules.reserve(count);
+	for (auto i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+	{
+		StyleRule rule;
+		stream >> rule.selector >> rule.objectName >> rule.className;
+
+		auto declarations = read_count(stream, minimumDeclarationSize);
+		rule.declarations.reserve(declarations);
+		for (auto j = 0; j < declarations && stream.status() == QDataStream::Ok; ++j)
+		{
+			StyleDeclaration declaration;
+			stream >> declaration.first >> declaration.second;
+			rule.declarations.append(declaration);
+		}
+		styleSheet.m_rules.append(rule);
+	}
+	return stream;
+}
@@ -0,0 +1,83 @@
+#ifndef __STYLESHEET__H_
+#define __STYLESHEET__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			namespace StyleTables { struct Table; }
+
+			typedef QPair<QString, QString> StyleDeclaration;
+
+			/**
+			* \brief One selector of a stylesheet with its declarations.
+			* A rule block with several comma separated selectors gives one rule per selector.
+			*/
+			struct StyleRule
+			{
+				QString selector;
+				QString objectName;
+				QString className;
+				QVector<StyleDeclaration> declarations;
+			};
+
+			/**
+			* \brief A stylesheet parsed once into rules indexed by objectName and class.
+			* The parsed form is cached on disk, one file per source checked against its size and
+			* time of change, so that a warm start does not read nor parse the source again.
+			* Qt still parses the canonical text given to QApplication::setStyleSheet.
+			* The variables of a stylesheet are given by its source or by the caller, ie: the tokens of a theme.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT StyleSheet
+			{
+			public:
+				StyleSheet();
+				static StyleSheet compile(const QByteArray &source, const QHash<QString, QString> &variables = QHash<QString, QString>());
+				static StyleSheet load(const QString &path, const QHash<QString, QString> &variables = QHash<QString, QString>());
+				static StyleSheet fromTable(const StyleTables::Table &table, const QHash<QString, QString> &variables = QHash<QString, QString>());
+				static QByteArray hashOf(const QByteArray &source, const QHash<QString, QString> &variables = QHash<QString, QString>());
+
+				bool isEmpty() const;
+				bool isFromCache() const;
+				QByteArray hash() const;
+				QString text() const;
+				const QVector<StyleRule> &rules() const;
+				QVector<const StyleRule *> rulesForObjectName(const QString &objectName) const;
+				QVector<const StyleRule *> rulesForClass(const QString &className) const;
+				QVector<StyleDeclaration> declarations(const QString &selector) const;
+				static QStringList changedSelectors(const StyleSheet &from, const StyleSheet &to);
+
+				friend STUDIOSOFTERWINDOWS_EXPORT QDataStream &operator<<(QDataStream &stream, const StyleSheet &styleSheet);
+				friend STUDIOSOFTERWINDOWS_EXPORT QDataStream &operator>>(QDataStream &stream, StyleSheet &styleSheet);
+
+			private:
+				void buildIndex();
+				static QString cachePath(const QString &sourcePath);
+
+				QVector<StyleRule> m_rules;
+				QHash<QString, QVector<int>> m_byObjectName;
+				QHash<QString, QVector<int>> m_byClass;
+				QHash<QString, QVector<int>> m_bySelector;
+				QByteArray m_hash;
+				QString m_text;
+				bool m_fromCache;
+			};
+
+			STUDIOSOFTERWINDOWS_EXPORT QDataStream &operator<<(QDataStream &stream, const StyleSheet &styleSheet);
+			STUDIOSOFTERWINDOWS_EXPORT QDataStream &operator>>(QDataStream &stream, StyleSheet &styleSheet);
+		}
+	}
+}
+
+#endif
\ No newline at end of file
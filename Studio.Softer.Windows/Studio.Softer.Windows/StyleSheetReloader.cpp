@@ -0,0 +1,332 @@
+#include "StyleSheetReloader.h"
+#include "ThemeEngine.h"
+
+#include <QFileSystemWatcher>
+#include <QElapsedTimer>
+#include <QApplication>
+#include <QWidget>
+#include <QTimer>
+#include <QRegExp>
+#include <QFile>
+#include <QSet>
+
+namespace {
+	// the widgets whose stylesheet was set by a reload, the others keep their own
+	const char *const overrideProperty = "styleSheetReloaderOverride";
+
+	// an editor saves a file in several writes, they are reloaded once
+	const int reloadDelay = 100; // milliseconds
+
+	auto rule_text(const Studio::Softer::Windows::StyleRule& rule) -> QString {
+		auto text = rule.selector + QLatin1Char('{');
+		for (const auto &declaration : rule.declarations)
+			text += declaration.first + QLatin1Char(':') + declaration.second + QLatin1Char(';');
+		return text + QLatin1Char('}');
+	}
+
+	auto property_names(const QVector<Studio::Softer::Windows::StyleDeclaration>& declarations) -> QSet<QString> {
+		QSet<QString> names;
+		for (const auto &declaration : declarations)
+			names.insert(declaration.first);
+		return names;
+	}
+
+	/* The specificity of a selector as in CSS 2, ie: "QToolButton#closeButton:hover" gives 1,1,1.
+	* The ids count for 10000, the attributes and pseudo-states for 100, the classes and sub-controls for 1.
+	*/
+	auto specificity(const QString& selector) -> int {
+		auto ids = 0, attributes = 0, elements = 0;
+		auto compoundStart = true;
+		for (auto i = 0; i < selector.size(); ++i)
+		{
+			auto c = selector[i];
+			if (c.isSpace() || c == QLatin1Char('>')) { compoundStart = true; continue; }
+
+			if (c == QLatin1Char('#')) ++ids;
+			else if (c == QLatin1Char('[')) { ++attributes; i = selector.indexOf(QLatin1Char(']'), i); if (i < 0) break; }
+			else if (c == QLatin1Char(':') && i + 1 < selector.size() && selector[i + 1] == QLatin1Char(':')) { ++elements; ++i; }
+			else if (c == QLatin1Char(':')) ++attributes;
+			else if (compoundStart && c != QLatin1Char('*')) ++elements;
+
+			// the rest of a name, ie: of the class or of the pseudo-state
+			while (i + 1 < selector.size() && (selector[i + 1].isLetterOrNumber() || selector[i + 1] == QLatin1Char('-') || selector[i + 1] == QLatin1Char('_') || selector[i + 1] == QLatin1Char('!') || selector[i + 1] == QLatin1Char('.')))
+				++i;
+			compoundStart = false;
+		}
+		return ids * 10000 + attributes * 100 + elements;
+	}
+
+	// the sub-control of the subject, ie: "item" for "QMenuBar::item:selected", rules of different ones do not compete
+	auto sub_control(const QString& selector) -> QString {
+		auto subject = selector.mid(selector.lastIndexOf(QRegExp("[\\s>]")) + 1);
+		auto start = subject.indexOf(QLatin1String("::"));
+		if (start < 0) return QString();
+		auto end = subject.indexOf(QLatin1Char(':'), start + 2);
+		return subject.mid(start + 2, end < 0 ? -1 : end - start - 2);
+	}
+
+	// a rule of every widget, its override would be set on the whole tree
+	auto is_universal(const Studio::Softer::Windows::StyleRule& rule) -> bool {
+		return rule.objectName.isEmpty() && (rule.className.isEmpty() || rule.className == QLatin1String("*") || rule.className == QLatin1String("QWidget"));
+	}
+
+	auto last_index(const QVector<Studio::Softer::Windows::StyleRule>& rules, const QString& selector) -> int {
+		for (auto i = rules.size() - 1; i >= 0; --i)
+		{
+			if (rules[i].selector == selector)
+				return i;
+		}
+		return -1;
+	}
+}
+
+
+Studio::Softer::Windows::StyleSheetReloader::StyleSheetReloader(const StyleSheet& applied) :
+	m_application(applied), m_current(applied), m_watcher(new QFileSystemWatcher), m_reloadTimer(new QTimer),
+	m_lastChangedSelectors(0), m_lastTouchedWidgets(0), m_reloads(0)
+{
+	m_reloadTimer->setSingleShot(true);
+	m_reloadTimer->setInterval(reloadDelay);
+	QObject::connect(m_reloadTimer, &QTimer::timeout, [this]() { reload(); });
+	QObject::connect(m_watcher, &QFileSystemWatcher::fileChanged, m_reloadTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+}
+
+
+Studio::Softer::Windows::StyleSheetReloader::~StyleSheetReloader()
+{
+	delete m_watcher;
+	delete m_reloadTimer;
+}
+
+
+/**
+* \brief Allows to reload a stylesheet file each time it is saved.
+* \param path The path of the file on the disk.
+* \return False when the file cannot be watched.
+*/
+bool Studio::Softer::Windows::StyleSheetReloader::watch(const QString& path)
+{
+	if (!m_path.isEmpty())
+		m_watcher->removePath(m_path);
+
+	m_path = path;
+	return m_watcher->addPath(path);
+}
+
+
+/**
+* \brief Allows to apply a new version of the stylesheet.
+* \param styleSheet The new version.
+* \return The number of widgets polished again.
+*/
+int Studio::Softer::Windows::StyleSheetReloader::apply(const StyleSheet& styleSheet)
+{
+	auto changed = StyleSheet::changedSelectors(m_current, styleSheet);
+	m_lastChangedSelectors = changed.size();
+	m_lastTouchedWidgets = 0;
+	if (changed.isEmpty())
+	{
+		m_current = styleSheet;
+		return 0;
+	}
+
+	// the rules of both versions, so that a widget also drops the rules reverted to the application ones
+	QVector<StyleRule> changedRules;
+	for (const auto &rule : m_current.rules() + styleSheet.rules())
+	{
+		if (changed.contains(rule.selector))
+			changedRules.append(rule);
+	}
+
+	// the rules that differ from the application stylesheet, a widget gets all those that match it
+	auto overrides = StyleSheet::changedSelectors(m_application, styleSheet);
+	QVector<QWidget *> widgets;
+	auto overridable = can_override(styleSheet);
+	for (const auto &rule : changedRules)
+	{
+		if (is_universal(rule))
+			overridable = false;
+	}
+
+	for (auto widget : QApplication::allWidgets())
+	{
+		if (!overridable)
+			break;
+
+		auto matched = false;
+		for (const auto &rule : changedRules)
+		{
+			if (!matches(widget, rule))
+				continue;
+
+			// a stylesheet set by the application itself is not replaced
+			if (!widget->styleSheet().isEmpty() && !widget->property(overrideProperty).toBool())
+				overridable = false;
+			if (is_shadowed(widget, rule, styleSheet, overrides))
+				overridable = false;
+			matched = true;
+		}
+		if (matched)
+			widgets.append(widget);
+	}
+
+	if (!overridable)
+	{
+		m_lastTouchedWidgets = replace_application_style_sheet(styleSheet);
+		m_current = styleSheet;
+		return m_lastTouchedWidgets;
+	}
+
+	for (auto widget : widgets)
+	{
+		QString text;
+		for (const auto &rule : styleSheet.rules())
+		{
+			if (overrides.contains(rule.selector) && matches(widget, rule))
+				text += rule_text(rule);
+		}
+
+		if (text == widget->styleSheet())
+			continue;
+
+		widget->setProperty(overrideProperty, !text.isEmpty());
+		widget->setStyleSheet(text);
+		++m_lastTouchedWidgets;
+	}
+
+	m_current = styleSheet;
+	return m_lastTouchedWidgets;
+}
+
+
+/**
+* \brief Allows to get the number of selectors changed by the last reload.
+* \return The number of selectors added, removed or modified.
+*/
+int Studio::Softer::Windows::StyleSheetReloader::lastChangedSelectors() const
+{
+	return m_lastChangedSelectors;
+}
+
+
+/**
+* \brief Allows to get the number of widgets polished again by the last reload.
+* \return The number of widgets, all of them when the application stylesheet was replaced.
+*/
+int Studio::Softer::Windows::StyleSheetReloader::lastTouchedWidgets() const
+{
+	return m_lastTouchedWidgets;
+}
+
+
+int Studio::Softer::Windows::StyleSheetReloader::reloadCount() const
+{
+	return m_reloads;
+}
+
+
+void Studio::Softer::Windows::StyleSheetReloader::reload()
+{
+	// an editor that saves by a rename replaces the watched file
+	if (!m_watcher->files().contains(m_path))
+		m_watcher->addPath(m_path);
+
+	QFile file(m_path);
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	auto styleSheet = StyleSheet::compile(file.readAll(), ThemeEngine::instance().styleSheetVariables());
+	if (styleSheet.hash() == m_current.hash())
+		return;
+
+	QElapsedTimer timer;
+	timer.start();
+	apply(styleSheet);
+	++m_reloads;
+
+	qInfo("Stylesheet %s reloaded in %lld ms: %d selectors changed, %d widgets polished",
+		qPrintable(m_path), timer.elapsed(), m_lastChangedSelectors, m_lastTouchedWidgets);
+}
+
+
+// the rules of the application stylesheet are only overridden, a removed property would stay
+bool Studio::Softer::Windows::StyleSheetReloader::can_override(const StyleSheet& styleSheet) const
+{
+	for (const auto &rule : m_application.rules())
+	{
+		auto names = property_names(styleSheet.declarations(rule.selector));
+		for (const auto &declaration : rule.declarations)
+		{
+			if (!names.contains(declaration.first))
+				return false;
+		}
+	}
+	return true;
+}
+
+
+// a rule of a widget stylesheet wins over every rule of the application, a more specific one included,
+// it cannot override a rule of the same property that Qt would apply after it, unless that rule is overridden too,
+// ie: "QMenuBar::item" and "QMenuBar::item:selected" both changed by a switch of theme
+bool Studio::Softer::Windows::StyleSheetReloader::is_shadowed(const QWidget* widget, const StyleRule& rule, const StyleSheet& styleSheet, const QStringList& overrides) const
+{
+	auto names = property_names(rule.declarations);
+	auto ruleSpecificity = specificity(rule.selector);
+	auto ruleIndex = last_index(styleSheet.rules(), rule.selector);
+	auto ruleSubControl = sub_control(rule.selector);
+
+	for (const auto &other : m_application.rules())
+	{
+		if (other.selector == rule.selector || overrides.contains(other.selector) || sub_control(other.selector) != ruleSubControl || !matches(widget, other))
+			continue;
+
+		auto shared = false;
+		for (const auto &declaration : other.declarations)
+			shared = shared || names.contains(declaration.first);
+		if (!shared)
+			continue;
+
+		auto otherSpecificity = specificity(other.selector);
+		if (otherSpecificity > ruleSpecificity || (otherSpecificity == ruleSpecificity && last_index(styleSheet.rules(), other.selector) > ruleIndex))
+			return true;
+	}
+	return false;
+}
+
+
+int Studio::Softer::Windows::StyleSheetReloader::replace_application_style_sheet(const StyleSheet& styleSheet)
+{
+	for (auto widget : QApplication::allWidgets())
+	{
+		if (widget->property(overrideProperty).toBool())
+		{
+			widget->setProperty(overrideProperty, false);
+			widget->setStyleSheet(QString());
+		}
+	}
+
+	qApp->setStyleSheet(styleSheet.text());
+	m_application = styleSheet;
+	return QApplication::allWidgets().size();
+}
+
+
+// the subject of the rule, the ancestors of its selector are matched by Qt
+bool Studio::Softer::Windows::StyleSheetReloader::matches(const QWidget* widget, const StyleRule& rule)
+{
+	if (!rule.objectName.isEmpty() && widget->objectName() != rule.objectName)
+		return false;
+
+	if (rule.className.isEmpty() || rule.className == QLatin1String("*"))
+		return true;
+
+	// a class in a namespace is written with "--", ie: ads--SectionWidget
+	auto className = QString(rule.className).replace(QLatin1String("--"), QLatin1String("::")).toLatin1();
+	for (auto meta = widget->metaObject(); meta; meta = meta->superClass())
+	{
+		QByteArray name(meta->className());
+		if (name == className || name.endsWith("::" + className))
+			return true;
+	}
+	return false;
+}
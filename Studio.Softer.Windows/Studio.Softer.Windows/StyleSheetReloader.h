@@ -0,0 +1,65 @@
+#ifndef __STYLESHEETRELOADER__H_
+#define __STYLESHEETRELOADER__H_
+
+#include "studiosofterwindows_global.h"
+#include "StyleSheet.h"
+
+class QFileSystemWatcher;
+class QWidget;
+class QTimer;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief Reloads a stylesheet from the disk when it is saved, for the development of a theme,
+			* and applies the stylesheet of a new theme after a switch.
+			* The new version is compared to the previous one by selector, only the widgets matched by a
+			* changed selector receive the new rules as their own stylesheet, above the one of the
+			* application, so that the rest of the widgets are not polished again. A rule or a property
+			* removed from the application stylesheet cannot be overridden, the whole stylesheet of the
+			* application is then replaced. It is also replaced when a changed rule applies to every widget,
+			* ie: "QWidget" or "*", or when a rule of the application that Qt would apply after a changed
+			* one matches the same widget, ie: a more specific one, since the stylesheet of a widget always
+			* wins over the one of the application. A widget created after a reload gets the overridden
+			* rules at the next reload that changes them. The variables of the stylesheet are the tokens of the
+			* current theme.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT StyleSheetReloader
+			{
+			public:
+				explicit StyleSheetReloader(const StyleSheet &applied);
+				~StyleSheetReloader();
+				bool watch(const QString &path);
+				int apply(const StyleSheet &styleSheet);
+				int lastChangedSelectors() const;
+				int lastTouchedWidgets() const;
+				int reloadCount() const;
+
+			private:
+				StyleSheetReloader(const StyleSheetReloader &) = delete;
+				StyleSheetReloader &operator=(const StyleSheetReloader &) = delete;
+
+				void reload();
+				bool can_override(const StyleSheet &styleSheet) const;
+				bool is_shadowed(const QWidget *widget, const StyleRule &rule, const StyleSheet &styleSheet, const QStringList &overrides) const;
+				int replace_application_style_sheet(const StyleSheet &styleSheet);
+				static bool matches(const QWidget *widget, const StyleRule &rule);
+
+				StyleSheet m_application;
+				StyleSheet m_current;
+				QString m_path;
+				QFileSystemWatcher *m_watcher;
+				QTimer *m_reloadTimer;
+				int m_lastChangedSelectors;
+				int m_lastTouchedWidgets;
+				int m_reloads;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef __STYLETABLES__H_
+#define __STYLETABLES__H_
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The constexpr form of a stylesheet, written by Studio.Softer.QssCompiler at build time.
+			* The rules are in the stylesheet order with their declarations, so that the stylesheet is
+			* indexed by objectName and class without parsing, their text is still parsed by Qt.
+			* The native rules, ie: of the title bar, the caption buttons and the palette, are painted by
+			* the widgets themselves. They are only written as colours and metrics by objectName or class
+			* and pseudo-state, read by ThemeEngine without parsing, and Qt never sees them.
+			*/
+			namespace StyleTables
+			{
+				struct Declaration
+				{
+					const char *property;
+					const char *value;
+				};
+
+				struct Rule
+				{
+					const char *selector;
+					const char *objectName;
+					const char *className;
+					const char *subControl;
+					const char *pseudoState;
+					int firstDeclaration;
+					int declarationCount;
+				};
+
+				//A colour of a native rule, a token of the theme or a literal, ie: background-color: @caption.hover.
+				struct Color
+				{
+					const char *objectName;
+					const char *className;
+					const char *pseudoState;
+					const char *property;
+					int token;
+					unsigned int argb;
+				};
+
+				//A length in pixels of a native rule, a token of the theme or a literal, ie: border-bottom-width: 1px.
+				struct Metric
+				{
+					const char *objectName;
+					const char *className;
+					const char *pseudoState;
+					const char *property;
+					int token;
+					int pixels;
+				};
+
+				struct Table
+				{
+					const char *source;
+					const char *hash;
+					const char *text;
+					const Rule *rules;
+					int ruleCount;
+					const Declaration *declarations;
+					int declarationCount;
+					const Color *colors;
+					int colorCount;
+					const Metric *metrics;
+					int metricCount;
+				};
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
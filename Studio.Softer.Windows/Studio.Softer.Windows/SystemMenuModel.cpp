@@ -0,0 +1,196 @@
+#include "SystemMenuModel.h"
+
+#include <QCoreApplication>
+#include <QMenu>
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#endif
+
+namespace {
+	// the Qt menu moves and sizes the window with QWindow::startSystemMove and startSystemResize
+#if defined(Q_OS_WIN) || QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	const bool systemMoveSupported = true;
+#else
+	const bool systemMoveSupported = false;
+#endif
+}
+
+
+Studio::Softer::Windows::SystemMenuModel::SystemMenuModel() :
+	m_state(Qt::WindowNoState), m_defaultCommand(Close), m_revision(0)
+{
+	for (auto command : { Restore, Move, Size, Minimize, Maximize, Close })
+		m_items.append(Item{ command, command != Restore && (systemMoveSupported || (command != Move && command != Size)) });
+}
+
+
+/**
+* \brief Allows to compute the items for a window state.
+* The active state and the other flags do not change the menu, they are ignored.
+* \param state The state of the window.
+* \return True when the items changed, the revision is then a new one.
+*/
+bool Studio::Softer::Windows::SystemMenuModel::update(Qt::WindowStates state)
+{
+	state &= Qt::WindowMinimized | Qt::WindowMaximized | Qt::WindowFullScreen;
+	if (state == m_state && m_revision > 0)
+		return false;
+
+	auto minimized = state.testFlag(Qt::WindowMinimized);
+	auto maximized = !minimized && (state & (Qt::WindowMaximized | Qt::WindowFullScreen));
+
+	for (auto &item : m_items)
+	{
+		switch (item.command)
+		{
+		case Restore: item.enabled = minimized || maximized; break;
+		case Move:
+		case Size: item.enabled = systemMoveSupported && !maximized; break;
+		case Minimize: item.enabled = !minimized; break;
+		case Maximize: item.enabled = !maximized; break;
+		case Close: item.enabled = true; break;
+		}
+	}
+
+	m_defaultCommand = minimized ? Restore : Close;
+	m_state = state;
+	++m_revision;
+	return true;
+}
+
+
+/**
+* \brief Allows to get the items, in the order of the menu.
+* \return The items.
+*/
+const QVector<Studio::Softer::Windows::SystemMenuModel::Item>& Studio::Softer::Windows::SystemMenuModel::items() const
+{
+	return m_items;
+}
+
+
+bool Studio::Softer::Windows::SystemMenuModel::isEnabled(Command command) const
+{
+	for (const auto &item : m_items)
+	{
+		if (item.command == command)
+			return item.enabled;
+	}
+	return false;
+}
+
+
+/**
+* \brief Allows to get the item in bold, the one of a double click on the title bar icon.
+* \return The command of the item.
+*/
+Studio::Softer::Windows::SystemMenuModel::Command Studio::Softer::Windows::SystemMenuModel::defaultCommand() const
+{
+	return m_defaultCommand;
+}
+
+
+/**
+* \brief Allows to know if a menu rendered from the model is up to date.
+* \return The revision, zero before the first update.
+*/
+quint64 Studio::Softer::Windows::SystemMenuModel::revision() const
+{
+	return m_revision;
+}
+
+
+/**
+* \brief Allows to get the text of an item, the system menu of Windows has its own.
+* \param command The command of the item.
+* \return The translated text, with its mnemonic.
+*/
+QString Studio::Softer::Windows::SystemMenuModel::text(Command command)
+{
+	switch (command)
+	{
+	case Restore: return QCoreApplication::translate("SystemMenuModel", "&Restore");
+	case Move: return QCoreApplication::translate("SystemMenuModel", "&Move");
+	case Size: return QCoreApplication::translate("SystemMenuModel", "&Size");
+	case Minimize: return QCoreApplication::translate("SystemMenuModel", "Mi&nimize");
+	case Maximize: return QCoreApplication::translate("SystemMenuModel", "Ma&ximize");
+	case Close: return QCoreApplication::translate("SystemMenuModel", "&Close");
+	}
+	return QString();
+}
+
+
+#ifdef Q_OS_WIN
+/**
+* \brief Allows to apply the model to the system menu of a window, see GetSystemMenu.
+* \param menu The menu.
+*/
+void Studio::Softer::Windows::SystemMenuModel::render(HMENU__ *menu) const
+{
+	MENUITEMINFO mii;
+	mii.cbSize = sizeof(MENUITEMINFO);
+	mii.fMask = MIIM_STATE;
+	mii.fType = 0;
+
+	for (const auto &item : m_items)
+	{
+		mii.fState = item.enabled ? MF_ENABLED : MF_GRAYED;
+		SetMenuItemInfo(menu, nativeCommand(item.command), FALSE, &mii);
+	}
+	SetMenuDefaultItem(menu, nativeCommand(m_defaultCommand), FALSE);
+}
+
+
+/**
+* \brief Allows to get the WM_SYSCOMMAND of a command.
+* \param command The command.
+* \return The system command, ie: SC_CLOSE.
+*/
+uint Studio::Softer::Windows::SystemMenuModel::nativeCommand(Command command)
+{
+	switch (command)
+	{
+	case Restore: return SC_RESTORE;
+	case Move: return SC_MOVE;
+	case Size: return SC_SIZE;
+	case Minimize: return SC_MINIMIZE;
+	case Maximize: return SC_MAXIMIZE;
+	case Close: return SC_CLOSE;
+	}
+	return 0;
+}
+#endif
+
+
+/**
+* \brief Allows to apply the model to a Qt menu, its actions are created on the first call.
+* The command of an action is its data, ie: static_cast<Command>(action->data().toInt()).
+* \param menu The menu.
+*/
+void Studio::Softer::Windows::SystemMenuModel::render(QMenu* menu) const
+{
+	if (menu->isEmpty())
+	{
+		for (const auto &item : m_items)
+		{
+			if (item.command == Close)
+				menu->addSeparator();
+
+			auto action = menu->addAction(text(item.command));
+			action->setData(item.command);
+			if (item.command == Close)
+				action->setShortcut(QKeySequence(Qt::ALT + Qt::Key_F4));
+		}
+	}
+
+	for (auto action : menu->actions())
+	{
+		if (action->isSeparator())
+			continue;
+
+		auto command = static_cast<Command>(action->data().toInt());
+		action->setEnabled(isEnabled(command));
+		if (command == m_defaultCommand)
+			menu->setDefaultAction(action);
+	}
+}
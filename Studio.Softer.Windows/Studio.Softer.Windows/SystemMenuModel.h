@@ -0,0 +1,69 @@
+#ifndef __SYSTEMMENUMODEL__H_
+#define __SYSTEMMENUMODEL__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QVector>
+#include <QString>
+
+class QMenu;
+#ifdef Q_OS_WIN
+struct HMENU__;
+#endif
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The items of the system menu of a frameless window, ie: the menu of the title bar icon.
+			* The enabled and default items are computed once per window state, the revision
+			* changes with them so that a renderer only updates its menu after a state change.
+			* Move and Size are disabled in the Qt menu before Qt 5.15, which has no system move nor resize.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT SystemMenuModel
+			{
+			public:
+				enum Command
+				{
+					Restore,
+					Move,
+					Size,
+					Minimize,
+					Maximize,
+					Close
+				};
+
+				struct Item
+				{
+					Command command;
+					bool enabled;
+				};
+
+				SystemMenuModel();
+				bool update(Qt::WindowStates state);
+				const QVector<Item> &items() const;
+				bool isEnabled(Command command) const;
+				Command defaultCommand() const;
+				quint64 revision() const;
+				static QString text(Command command);
+
+#ifdef Q_OS_WIN
+				void render(HMENU__ *menu) const;
+				static uint nativeCommand(Command command);
+#endif
+				void render(QMenu *menu) const;
+
+			private:
+				QVector<Item> m_items;
+				Qt::WindowStates m_state;
+				Command m_defaultCommand;
+				quint64 m_revision;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include "ThemeEngine.h"
+#include "ThemeTokens.h"
+#include "StyleTables.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QApplication>
+#include <QFileInfo>
+#include <QObject>
+#include <QFile>
+#include <QDir>
+
+namespace {
+	static_assert(Studio::Softer::Windows::ThemeTokens::count == Studio::Softer::Windows::ThemeEngine::TokenCount, "a token has no name");
+
+	auto dark_theme() -> Studio::Softer::Windows::Theme {
+		Studio::Softer::Windows::Theme theme;
+		theme.name = "dark";
+		theme.styleSheetPath = ":/themes/Style.qss";
+		theme.tokens = {
+			{ "window.background", QColor("#303030") },
+			{ "window.text", QColor("#ffffff") },
+			{ "titleBar.background", QColor("#282828") },
+			{ "content.background", QColor("#282828") },
+			{ "panel.background", QColor("#383838") },
+			{ "caption.hover", QColor("#404040") },
+			{ "caption.pressed", QColor("#4a4a4a") },
+			{ "menu.background", QColor("#424242") },
+			{ "menu.selected", QColor("#303030") },
+			{ "menu.separator", QColor("#333337") },
+			{ "border", QColor("#202020") },
+			{ "separator", QColor("#303030") },
+			{ "toolBar.border", QColor("#252525") },
+			{ "toolTip.background", QColor("#f1f2f7") },
+			{ "toolTip.text", QColor("#000000") },
+			{ "toolTip.border", QColor("#767676") },
+			{ "dock.background", QColor("#404040") },
+			{ "dock.splitter", QColor("#101010") },
+			{ "dock.section", QColor("#a0a0a0") },
+			{ "menuBar.spacing", 10 },
+			{ "toolBar.spacing", 5 },
+			{ "toolBar.padding", 3 }
+		};
+		return theme;
+	}
+
+	auto light_theme() -> Studio::Softer::Windows::Theme {
+		Studio::Softer::Windows::Theme theme;
+		theme.name = "light";
+		theme.styleSheetPath = ":/themes/Style.qss";
+		theme.tokens = {
+			{ "window.background", QColor("#f0f0f0") },
+			{ "window.text", QColor("#202020") },
+			{ "titleBar.background", QColor("#e6e6e6") },
+			{ "content.background", QColor("#f5f5f5") },
+			{ "panel.background", QColor("#ebebeb") },
+			{ "caption.hover", QColor("#d4d4d4") },
+			{ "caption.pressed", QColor("#c4c4c4") },
+			{ "menu.background", QColor("#fafafa") },
+			{ "menu.selected", QColor("#dcdcdc") },
+			{ "menu.separator", QColor("#d0d0d0") },
+			{ "border", QColor("#c8c8c8") },
+			{ "separator", QColor("#dcdcdc") },
+			{ "toolBar.border", QColor("#c8c8c8") },
+			{ "toolTip.background", QColor("#ffffe1") },
+			{ "toolTip.text", QColor("#000000") },
+			{ "toolTip.border", QColor("#767676") },
+			{ "dock.background", QColor("#d4d4d4") },
+			{ "dock.splitter", QColor("#b0b0b0") },
+			{ "dock.section", QColor("#d0d0d0") },
+			{ "menuBar.spacing", 10 },
+			{ "toolBar.spacing", 5 },
+			{ "toolBar.padding", 3 }
+		};
+		return theme;
+	}
+
+	// a colour is written as a string, ie: "#404040", a metric as a number
+	auto token_value(const QVariant& value) -> QVariant {
+		if (value.type() == QVariant::String)
+		{
+			QColor color(value.toString());
+			return color.isValid() ? QVariant(color) : value;
+		}
+		if (value.canConvert<int>())
+			return value.toInt();
+		return value;
+	}
+
+	// the roles of the palette by property of the native rule "QPalette", with their tokens without a table
+	struct PaletteRole
+	{
+		QPalette::ColorRole role;
+		const char *property;
+		Studio::Softer::Windows::ThemeEngine::Token token;
+	};
+
+	const PaletteRole paletteRoles[] = {
+		{ QPalette::Window, "window", Studio::Softer::Windows::ThemeEngine::WindowBackground },
+		{ QPalette::WindowText, "window-text", Studio::Softer::Windows::ThemeEngine::WindowText },
+		{ QPalette::Base, "base", Studio::Softer::Windows::ThemeEngine::ContentBackground },
+		{ QPalette::AlternateBase, "alternate-base", Studio::Softer::Windows::ThemeEngine::PanelBackground },
+		{ QPalette::Text, "text", Studio::Softer::Windows::ThemeEngine::WindowText },
+		{ QPalette::Button, "button", Studio::Softer::Windows::ThemeEngine::PanelBackground },
+		{ QPalette::ButtonText, "button-text", Studio::Softer::Windows::ThemeEngine::WindowText },
+		{ QPalette::Highlight, "highlight", Studio::Softer::Windows::ThemeEngine::CaptionHover },
+		{ QPalette::HighlightedText, "highlighted-text", Studio::Softer::Windows::ThemeEngine::WindowText },
+		{ QPalette::ToolTipBase, "tool-tip-base", Studio::Softer::Windows::ThemeEngine::ToolTipBackground },
+		{ QPalette::ToolTipText, "tool-tip-text", Studio::Softer::Windows::ThemeEngine::ToolTipText }
+	};
+
+	// a typed value of a native rule, its subject is its objectName or else its class
+	template <typename Entry>
+	auto is_subject(const Entry& entry, const char *subject) -> bool {
+		return qstrcmp(*entry.objectName ? entry.objectName : entry.className, subject) == 0;
+	}
+
+	template <typename Entry>
+	auto find_entry(const Entry *entries, int count, const char *subject, const char *pseudoState, const char *property) -> const Entry * {
+		for (auto i = 0; i < count; ++i)
+		{
+			if (is_subject(entries[i], subject) && qstrcmp(entries[i].pseudoState, pseudoState) == 0 && qstrcmp(entries[i].property, property) == 0)
+				return &entries[i];
+		}
+		return Q_NULLPTR;
+	}
+}
+
+
+Studio::Softer::Windows::ThemeEngine::ThemeEngine() :
+	m_styleTable(Q_NULLPTR), m_current("dark"), m_nextBinding(0), m_lastUpdates(0), m_lastSwitchTime(0), m_lastResolveTime(0)
+{
+	addTheme(dark_theme());
+	addTheme(light_theme());
+}
+
+
+/**
+* \brief Allows to get the process wide theme engine.
+* \return The theme engine, with the dark theme as the current one.
+*/
+Studio::Softer::Windows::ThemeEngine& Studio::Softer::Windows::ThemeEngine::instance()
+{
+	static ThemeEngine engine;
+	return engine;
+}
+
+
+QString Studio::Softer::Windows::ThemeEngine::tokenName(Token token)
+{
+	return QString::fromLatin1(ThemeTokens::names[token]);
+}
+
+
+/**
+* \brief Allows to get the index of a token from its name, ie: for the tokens of a theme file.
+* \param name The name of the token, ie: "caption.hover".
+* \return The index, TokenCount when no token has this name.
+*/
+Studio::Softer::Windows::ThemeEngine::Token Studio::Softer::Windows::ThemeEngine::tokenIndex(const QString& name)
+{
+	for (auto i = 0; i < TokenCount; ++i)
+	{
+		if (name == QLatin1String(ThemeTokens::names[i]))
+			return static_cast<Token>(i);
+	}
+	return TokenCount;
+}
+
+
+/**
+* \brief Allows to add a theme, or to replace the one with the same name.
+* The bindings are not called when the current theme is replaced, setTheme() updates the widgets.
+* \param theme The theme.
+*/
+void Studio::Softer::Windows::ThemeEngine::addTheme(const Theme& theme)
+{
+	m_themes.insert(theme.name, theme);
+	if (theme.name == m_current)
+		resolve(theme, m_resolved);
+}
+
+
+/**
+* \brief Allows to add a custom theme from a JSON file.
+* The file gives its name, the theme it is based on and the tokens it changes, ie:
+* { "name": "blue", "base": "dark", "styleSheet": "blue.qss", "tokens": { "caption.hover": "#3a5a80" } }
+* \param path The path of the file.
+* \return The name of the theme, empty when the file cannot be read.
+*/
+QString Studio::Softer::Windows::ThemeEngine::loadTheme(const QString& path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+		return QString();
+
+	auto object = QJsonDocument::fromJson(file.readAll()).object();
+	auto name = object.value("name").toString(QFileInfo(path).baseName());
+	if (name.isEmpty())
+		return QString();
+
+	auto theme = m_themes.value(object.value("base").toString("dark"), dark_theme());
+	theme.name = name;
+
+	if (object.contains("styleSheet"))
+	{
+		auto styleSheet = object.value("styleSheet").toString();
+		theme.styleSheetPath = QFileInfo(styleSheet).isRelative() && !styleSheet.startsWith(':')
+			? QFileInfo(path).absoluteDir().filePath(styleSheet) : styleSheet;
+	}
+
+	auto tokens = object.value("tokens").toObject().toVariantMap();
+	for (auto it = tokens.cbegin(); it != tokens.cend(); ++it)
+		theme.tokens.insert(it.key(), token_value(it.value()));
+
+	addTheme(theme);
+	return name;
+}
+
+
+/**
+* \brief Allows to get the names of the themes.
+* \return The names, sorted.
+*/
+QStringList Studio::Softer::Windows::ThemeEngine::themes() const
+{
+	auto names = m_themes.keys();
+	names.sort();
+	return names;
+}
+
+
+/**
+* \brief Allows to change the current theme.
+* Only the bindings of the tokens whose value differs between the two themes are called.
+* \param name The name of the theme.
+* \return False when there is no theme with this name.
+*/
+bool Studio::Softer::Windows::ThemeEngine::setTheme(const QString& name)
+{
+	auto next = m_themes.constFind(name);
+	if (next == m_themes.constEnd())
+		return false;
+
+	QElapsedTimer timer;
+	timer.start();
+
+	ResolvedToken resolved[TokenCount];
+	resolve(*next, resolved);
+	m_lastResolveTime = timer.nsecsElapsed();
+
+	// a binding of several changed tokens is called once
+	QSet<int> bindings;
+	for (auto i = 0; i < TokenCount; ++i)
+	{
+		if (resolved[i].value != m_resolved[i].value)
+			bindings.unite(m_byToken[i]);
+		m_resolved[i] = resolved[i];
+	}
+
+	m_current = name;
+
+	for (auto id : bindings)
+	{
+		auto binding = m_bindings.constFind(id);
+		if (binding != m_bindings.constEnd())
+			binding->apply();
+	}
+
+	m_lastUpdates = bindings.size();
+	m_lastSwitchTime = timer.nsecsElapsed();
+	return true;
+}
+
+
+const Studio::Softer::Windows::Theme& Studio::Softer::Windows::ThemeEngine::theme() const
+{
+	return *m_themes.constFind(m_current);
+}
+
+
+QString Studio::Softer::Windows::ThemeEngine::themeName() const
+{
+	return m_current;
+}
+
+
+/**
+* \brief Allows to get the value of a token in the current theme.
+* \param token The token.
+* \return The value, a QColor for a colour and an int for a metric.
+*/
+QVariant Studio::Softer::Windows::ThemeEngine::token(Token token) const
+{
+	return m_resolved[token].value;
+}
+
+
+QColor Studio::Softer::Windows::ThemeEngine::color(Token token) const
+{
+	return m_resolved[token].color;
+}
+
+
+int Studio::Softer::Windows::ThemeEngine::metric(Token token) const
+{
+	return m_resolved[token].metric;
+}
+
+
+/**
+* \brief Allows to get the value of a token by name, ie: a token of a theme file that has no index.
+* \param name The name of the token, ie: "caption.hover".
+* \return The value, a QColor for a colour and an int for a metric.
+*/
+QVariant Studio::Softer::Windows::ThemeEngine::token(const QString& name) const
+{
+	auto index = tokenIndex(name);
+	return index == TokenCount ? theme().tokens.value(name) : token(index);
+}
+
+
+QColor Studio::Softer::Windows::ThemeEngine::color(const QString& name) const
+{
+	return token(name).value<QColor>();
+}
+
+
+int Studio::Softer::Windows::ThemeEngine::metric(const QString& name) const
+{
+	return token(name).toInt();
+}
+
+
+/**
+* \brief Allows to read the native rules of a stylesheet from its typed tables, ie: the colours of the title bar.
+* The bindings already made keep the tokens they were made with, the table is set before the first widget.
+* \param table The table of a generated header, ie: Studio::Softer::Styles::Style::table, null for none.
+*/
+void Studio::Softer::Windows::ThemeEngine::setStyleTable(const StyleTables::Table* table)
+{
+	m_styleTable = table;
+}
+
+
+/**
+* \brief Allows to get a colour of a native rule, resolved with the tokens of the current theme.
+* \param subject The objectName or else the class of the rule, ie: "windowTitleBar" or "CaptionButton".
+* \param pseudoState The pseudo-state of the rule, ie: "hover", empty for none.
+* \param property The property, ie: "background-color".
+* \param fallback The colour without a table or without this rule.
+* \return The colour.
+*/
+QColor Studio::Softer::Windows::ThemeEngine::styleColor(const char* subject, const char* pseudoState, const char* property, const QColor& fallback) const
+{
+	if (!m_styleTable) return fallback;
+
+	auto entry = find_entry(m_styleTable->colors, m_styleTable->colorCount, subject, pseudoState, property);
+	if (!entry) return fallback;
+	return entry->token < 0 ? QColor::fromRgba(entry->argb) : m_resolved[entry->token].color;
+}
+
+
+/**
+* \brief Allows to get a length in pixels of a native rule, resolved with the tokens of the current theme.
+* \param subject The objectName or else the class of the rule.
+* \param pseudoState The pseudo-state of the rule, empty for none.
+* \param property The property, ie: "border-bottom-width".
+* \param fallback The length without a table or without this rule.
+* \return The length in pixels.
+*/
+int Studio::Softer::Windows::ThemeEngine::styleMetric(const char* subject, const char* pseudoState, const char* property, int fallback) const
+{
+	if (!m_styleTable) return fallback;
+
+	auto entry = find_entry(m_styleTable->metrics, m_styleTable->metricCount, subject, pseudoState, property);
+	if (!entry) return fallback;
+	return entry->token < 0 ? entry->pixels : m_resolved[entry->token].metric;
+}
+
+
+/**
+* \brief Allows to get the tokens of the native rules of a subject, to bind the widget that paints them.
+* \param subject The objectName or else the class of the rules.
+* \param fallback The tokens without a table.
+* \return The tokens of all the pseudo-states, each one once.
+*/
+QVector<Studio::Softer::Windows::ThemeEngine::Token> Studio::Softer::Windows::ThemeEngine::styleTokens(const char* subject, const QVector<Token>& fallback) const
+{
+	if (!m_styleTable) return fallback;
+
+	QVector<Token> tokens;
+	auto add = [&tokens](int token, bool matched)
+	{
+		if (matched && token >= 0 && !tokens.contains(static_cast<Token>(token)))
+			tokens.append(static_cast<Token>(token));
+	};
+	for (auto i = 0; i < m_styleTable->colorCount; ++i)
+		add(m_styleTable->colors[i].token, is_subject(m_styleTable->colors[i], subject));
+	for (auto i = 0; i < m_styleTable->metricCount; ++i)
+		add(m_styleTable->metrics[i].token, is_subject(m_styleTable->metrics[i], subject));
+	return tokens;
+}
+
+
+/**
+* \brief Allows to get the tokens of the roles of the palette.
+* \return The tokens read by palette().
+*/
+QVector<Studio::Softer::Windows::ThemeEngine::Token> Studio::Softer::Windows::ThemeEngine::paletteTokens() const
+{
+	QVector<Token> tokens;
+	for (const auto &role : paletteRoles)
+	{
+		if (!tokens.contains(role.token))
+			tokens.append(role.token);
+	}
+	return styleTokens("QPalette", tokens);
+}
+
+
+/**
+* \brief Allows to get the palette of the current theme, ie: for the application before its first widget.
+* \return The palette.
+*/
+QPalette Studio::Softer::Windows::ThemeEngine::palette() const
+{
+	QPalette palette;
+	for (const auto &role : paletteRoles)
+		palette.setColor(role.role, styleColor("QPalette", "", role.property, color(role.token)));
+	return palette;
+}
+
+
+/**
+* \brief Allows to get the values of the variables of a stylesheet in the current theme,
+* read from the resolved tokens, ie: "#383838" for "panel.background" and "10px" for "menuBar.spacing".
+* \return The values by token name.
+*/
+QHash<QString, QString> Studio::Softer::Windows::ThemeEngine::styleSheetVariables() const
+{
+	QHash<QString, QString> variables;
+	variables.reserve(TokenCount);
+	for (auto i = 0; i < TokenCount; ++i)
+	{
+		const auto &resolved = m_resolved[i];
+		QString value;
+		if (resolved.value.type() == QVariant::Color)
+			value = resolved.color.name(resolved.color.alpha() == 255 ? QColor::HexRgb : QColor::HexArgb);
+		else if (resolved.value.type() == QVariant::Int)
+			value = QString::number(resolved.metric) + QLatin1String("px");
+		else
+			value = resolved.value.toString();
+		variables.insert(QString::fromLatin1(ThemeTokens::names[i]), value);
+	}
+	return variables;
+}
+
+
+/**
+* \brief Allows a widget to follow the theme, the function is called now and after each switch
+* that changes one of its tokens. The binding is removed when the target is destroyed.
+* \param target The object that reads the tokens, ie: a widget.
+* \param tokens The tokens read by the function.
+* \param apply The function that reads the tokens and updates the target.
+*/
+void Studio::Softer::Windows::ThemeEngine::bind(QObject* target, const QVector<Token>& tokens, const std::function<void()>& apply)
+{
+	auto id = m_nextBinding++;
+	m_bindings.insert(id, Binding{ tokens, apply });
+	for (const auto &token : tokens)
+		m_byToken[token].insert(id);
+
+	QObject::connect(target, &QObject::destroyed, [this, id]() { unbind(id); });
+	apply();
+}
+
+
+/**
+* \brief Allows the application to follow the theme, its palette and its stylesheet are applied
+* now and after each switch. The palette is only bound to the tokens of its roles. The stylesheet
+* is not set again on the application, that would polish every widget, the function applies the
+* rules whose tokens changed to the widgets they match, see StyleSheetReloader.
+* \param application The application.
+* \param styleSheet The function that applies the stylesheet of a theme.
+*/
+void Studio::Softer::Windows::ThemeEngine::bindApplication(QApplication* application, const std::function<void(const Theme &)>& styleSheet)
+{
+	bind(application, paletteTokens(), [this, application]() { application->setPalette(palette()); });
+
+	QVector<Token> tokens;
+	for (auto i = 0; i < TokenCount; ++i)
+		tokens.append(static_cast<Token>(i));
+
+	bind(application, tokens, [this, styleSheet]() { styleSheet(theme()); });
+}
+
+
+int Studio::Softer::Windows::ThemeEngine::bindingCount() const
+{
+	return m_bindings.size();
+}
+
+
+/**
+* \brief Allows to get the number of bindings called by the last switch.
+* \return The number of updated targets.
+*/
+int Studio::Softer::Windows::ThemeEngine::lastUpdateCount() const
+{
+	return m_lastUpdates;
+}
+
+
+/**
+* \brief Allows to get the duration of the last switch, the bindings included.
+* \return The duration, in nanoseconds.
+*/
+qint64 Studio::Softer::Windows::ThemeEngine::lastSwitchTime() const
+{
+	return m_lastSwitchTime;
+}
+
+
+/**
+* \brief Allows to get the duration of the resolution of the tokens by the last switch.
+* \return The duration, in nanoseconds.
+*/
+qint64 Studio::Softer::Windows::ThemeEngine::lastResolveTime() const
+{
+	return m_lastResolveTime;
+}
+
+
+void Studio::Softer::Windows::ThemeEngine::unbind(int id)
+{
+	auto binding = m_bindings.find(id);
+	if (binding == m_bindings.end())
+		return;
+
+	for (const auto &token : binding->tokens)
+		m_byToken[token].remove(id);
+	m_bindings.erase(binding);
+}
+
+
+void Studio::Softer::Windows::ThemeEngine::resolve(const Theme& theme, ResolvedToken* resolved)
+{
+	for (auto i = 0; i < TokenCount; ++i)
+	{
+		auto value = theme.tokens.value(QLatin1String(ThemeTokens::names[i]));
+		resolved[i].value = value;
+		resolved[i].color = value.value<QColor>();
+		resolved[i].metric = value.toInt();
+	}
+}
@@ -0,0 +1,147 @@
+#ifndef __THEMEENGINE__H_
+#define __THEMEENGINE__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <QPalette>
+#include <QColor>
+#include <QHash>
+#include <QSet>
+#include <functional>
+
+class QObject;
+class QApplication;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			namespace StyleTables { struct Table; }
+
+			/**
+			* \brief A theme of the application, ie: dark or light.
+			* The tokens are the colours and metrics of the theme by name, ie: "caption.hover".
+			* Its stylesheet uses the same names as variables, ie: "background-color: @panel.background;",
+			* the built-in themes share one stylesheet and only differ by their tokens.
+			*/
+			struct Theme
+			{
+				QString name;
+				QString styleSheetPath;
+				QHash<QString, QVariant> tokens;
+			};
+
+			/**
+			* \brief The themes of the application and the widgets that follow the current one.
+			* A widget binds a function to the tokens it uses, a switch of theme only calls the
+			* functions of the tokens whose value changed, so that no other widget is polished
+			* or repainted. The palette of the application is bound to the tokens of its roles, its
+			* stylesheet is kept and the changed rules are applied to the widgets they match, see bindApplication.
+			* The tokens of the current theme are resolved once per switch into a flat array,
+			* read by index without hashing nor QVariant conversion. The native rules of the stylesheet,
+			* ie: of the palette and the title bar, are read from its typed tables, see setStyleTable.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT ThemeEngine
+			{
+			public:
+				enum Token
+				{
+					WindowBackground,
+					WindowText,
+					TitleBarBackground,
+					ContentBackground,
+					PanelBackground,
+					CaptionHover,
+					CaptionPressed,
+					MenuBackground,
+					MenuSelected,
+					MenuSeparator,
+					Border,
+					Separator,
+					ToolBarBorder,
+					ToolTipBackground,
+					ToolTipText,
+					ToolTipBorder,
+					DockBackground,
+					DockSplitter,
+					DockSection,
+					MenuBarSpacing,
+					ToolBarSpacing,
+					ToolBarPadding,
+					TokenCount
+				};
+
+				static ThemeEngine &instance();
+				static QString tokenName(Token token);
+				static Token tokenIndex(const QString &name);
+
+				void addTheme(const Theme &theme);
+				QString loadTheme(const QString &path);
+				QStringList themes() const;
+				bool setTheme(const QString &name);
+				const Theme &theme() const;
+				QString themeName() const;
+
+				QVariant token(Token token) const;
+				QColor color(Token token) const;
+				int metric(Token token) const;
+				QVariant token(const QString &name) const;
+				QColor color(const QString &name) const;
+				int metric(const QString &name) const;
+				void setStyleTable(const StyleTables::Table *table);
+				QColor styleColor(const char *subject, const char *pseudoState, const char *property, const QColor &fallback) const;
+				int styleMetric(const char *subject, const char *pseudoState, const char *property, int fallback) const;
+				QVector<Token> styleTokens(const char *subject, const QVector<Token> &fallback) const;
+				QVector<Token> paletteTokens() const;
+				QPalette palette() const;
+				QHash<QString, QString> styleSheetVariables() const;
+
+				void bind(QObject *target, const QVector<Token> &tokens, const std::function<void()> &apply);
+				void bindApplication(QApplication *application, const std::function<void(const Theme &)> &styleSheet);
+				int bindingCount() const;
+				int lastUpdateCount() const;
+				qint64 lastSwitchTime() const;
+				qint64 lastResolveTime() const;
+
+			private:
+				struct Binding
+				{
+					QVector<Token> tokens;
+					std::function<void()> apply;
+				};
+
+				struct ResolvedToken
+				{
+					QVariant value;
+					QColor color;
+					int metric;
+				};
+
+				ThemeEngine();
+				ThemeEngine(const ThemeEngine &) = delete;
+				ThemeEngine &operator=(const ThemeEngine &) = delete;
+
+				void unbind(int id);
+				static void resolve(const Theme &theme, ResolvedToken *resolved);
+
+				const StyleTables::Table *m_styleTable;
+				QHash<QString, Theme> m_themes;
+				QString m_current;
+				QHash<int, Binding> m_bindings;
+				ResolvedToken m_resolved[TokenCount];
+				QSet<int> m_byToken[TokenCount];
+				int m_nextBinding;
+				int m_lastUpdates;
+				qint64 m_lastSwitchTime;
+				qint64 m_lastResolveTime;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
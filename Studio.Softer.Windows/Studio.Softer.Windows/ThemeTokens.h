@@ -0,0 +1,48 @@
+#ifndef __THEMETOKENS__H_
+#define __THEMETOKENS__H_
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The names of the tokens of a theme, in the order of ThemeEngine::Token.
+			* A stylesheet uses them as variables, ie: "background-color: @panel.background;",
+			* Studio.Softer.QssCompiler checks them at build time and the current theme gives their values.
+			*/
+			namespace ThemeTokens
+			{
+				constexpr const char *const names[] = {
+					"window.background",
+					"window.text",
+					"titleBar.background",
+					"content.background",
+					"panel.background",
+					"caption.hover",
+					"caption.pressed",
+					"menu.background",
+					"menu.selected",
+					"menu.separator",
+					"border",
+					"separator",
+					"toolBar.border",
+					"toolTip.background",
+					"toolTip.text",
+					"toolTip.border",
+					"dock.background",
+					"dock.splitter",
+					"dock.section",
+					"menuBar.spacing",
+					"toolBar.spacing",
+					"toolBar.padding"
+				};
+
+				constexpr int count = sizeof(names) / sizeof(*names);
+			}
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -1,592 +1,1042 @@
-#include "Window.h"
-#include "Designer.h"
-
-#include <cmath>
-#include <QLayout>
-#include <dwmapi.h>
-#include <windows.h>
-#include <windowsx.h>
-#include <QApplication>
-#pragma comment(lib, "dwmapi.lib")
-
-namespace {
-	// we cannot just use WS_POPUP style
-	// WS_THICKFRAME: without this the window cannot be resized and so aero snap, de-maximizing and minimizing won't work
-	// WS_SYSMENU: enables the context menu with the move, close, maximize, minimize... commands (shift + right-click on the task bar item)
-	// WS_CAPTION: enables aero minimize animation/transition
-	// WS_MAXIMIZEBOX, WS_MINIMIZEBOX: enable minimize/maximize
-	enum class Style : DWORD {
-		windowed = WS_OVERLAPPEDWINDOW | WS_THICKFRAME | WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX,
-		aero_borderless = WS_POPUP | WS_THICKFRAME | WS_CAPTION | WS_SYSMENU | WS_MAXIMIZEBOX | WS_MINIMIZEBOX,
-		basic_borderless = WS_POPUP | WS_THICKFRAME | WS_SYSMENU | WS_MAXIMIZEBOX | WS_MINIMIZEBOX
-	};
-
-	auto maximized(HWND hwnd) -> bool {
-		WINDOWPLACEMENT placement;
-		if (!::GetWindowPlacement(hwnd, &placement)) {
-			return false;
-		}
-
-		return placement.showCmd == SW_MAXIMIZE;
-	}
-
-	/* Adjust client rect to not spill over monitor edges when maximized.
-	* rect(in/out): in: proposed window rect, out: calculated client rect
-	* Does nothing if the window is not maximized.
-	*/
-	auto adjust_maximized_client_rect(HWND window, RECT& rect) -> void {
-		if (!maximized(window)) {
-			return;
-		}
-
-		auto monitor = ::MonitorFromWindow(window, MONITOR_DEFAULTTONULL);
-		if (!monitor) {
-			return;
-		}
-
-		MONITORINFO monitor_info{};
-		monitor_info.cbSize = sizeof(monitor_info);
-		if (!::GetMonitorInfoW(monitor, &monitor_info)) {
-			return;
-		}
-
-		// when maximized, make the client area fill just the monitor (without task bar) rect,
-		// not the whole window rect which extends beyond the monitor.
-		rect = monitor_info.rcWork;
-	}
-
-	auto composition_enabled() -> bool {
-		auto composition_enabled = FALSE;
-		auto success = ::DwmIsCompositionEnabled(&composition_enabled) == S_OK;
-		return composition_enabled && success;
-	}
-
-	auto select_borderless_style() -> Style {
-		return composition_enabled() ? Style::aero_borderless : Style::basic_borderless;
-	}
-}
-
-Studio::Softer::Windows::Window::Window(QMenuBar *menuBar)
-	: minimize_button_(Q_NULLPTR), maximize_button_(Q_NULLPTR), restore_button_(Q_NULLPTR),
-	close_Button_(Q_NULLPTR), title_bar_widget_(Q_NULLPTR), icon_button_(Q_NULLPTR)
-{
-	setWindowFlags(Qt::FramelessWindowHint);
-	set_borderless(true);
-
-	// set black background
-	auto pal = palette();
-	pal.setColor(QPalette::Background, Qt::black);
-	setAutoFillBackground(true);
-	setPalette(pal);
-	setBackgroundRole(QPalette::Dark);
-
-	auto horizontalLayout = new QHBoxLayout();
-	horizontalLayout->setSpacing(0);
-	horizontalLayout->setMargin(0);
-
-	//Represent the window title bar.
-	title_bar_widget_ = new QWidget(this);
-	title_bar_widget_->setFixedHeight(30);
-	title_bar_widget_->setObjectName("windowTitleBar");
-	title_bar_widget_->setContentsMargins(0, 0, 0, 0);
-	title_bar_widget_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-	title_bar_widget_->setLayout(horizontalLayout);
-
-	icon_button_ = new QPushButton(title_bar_widget_);
-	icon_button_->setIconSize(QSize(20, 20));
-	icon_button_->setStyleSheet("margin-left: 5px; background-color: transparent; border: none;");
-	icon_button_->setObjectName("titleBarIcon");
-	icon_button_->setFocusPolicy(Qt::NoFocus);
-	connect(icon_button_, SIGNAL(clicked()), this, SLOT(slot_show_system_menu()));
-
-	//Represent the minimize button.
-	minimize_button_ = new QPushButton(title_bar_widget_);
-	minimize_button_->setFixedSize(36, 29);
-	minimize_button_->setObjectName("minimizeButton");
-	minimize_button_->setToolTip(tr("Minimize"));
-	minimize_button_->setFocusPolicy(Qt::NoFocus);
-	connect(minimize_button_, SIGNAL(clicked()), this, SLOT(slot_minimized()));
-
-	//Represent the maximize button.
-	maximize_button_ = new QPushButton(title_bar_widget_);
-	maximize_button_->setFixedSize(36, 29);
-	maximize_button_->setObjectName("maximizeButton");
-	maximize_button_->setToolTip(tr("Maximize"));
-	maximize_button_->setVisible(true);
-	maximize_button_->setFocusPolicy(Qt::NoFocus);
-	connect(maximize_button_, SIGNAL(clicked()), this, SLOT(slot_maximized()));
-
-	//Represent the restore button.
-	restore_button_ = new QPushButton(title_bar_widget_);
-	restore_button_->setFixedSize(36, 29);
-	restore_button_->setObjectName("restoreButton");
-	restore_button_->setToolTip(tr("Restore"));
-	restore_button_->setVisible(false);
-	restore_button_->setFocusPolicy(Qt::NoFocus);
-	connect(restore_button_, SIGNAL(clicked()), this, SLOT(slot_restored()));
-
-	//Represent the close button.
-	close_Button_ = new QPushButton(title_bar_widget_);
-	close_Button_->setFixedSize(36, 29);
-	close_Button_->setObjectName("closeButton");
-	close_Button_->setToolTip(tr("Close"));
-	close_Button_->setFocusPolicy(Qt::NoFocus);
-	connect(close_Button_, SIGNAL(clicked()), this, SLOT(slot_closed()));
-
-	//Add icon on the title bar.
-	horizontalLayout->addWidget(icon_button_);
-
-	//Add a menu bar on the window title bar.
-	horizontalLayout->addWidget(menuBar);
-
-	//Add space beetwen the menubar and command icon
-	horizontalLayout->addStretch(1);
-
-	//Add button command.
-	horizontalLayout->addWidget(minimize_button_);
-	horizontalLayout->addWidget(restore_button_);
-	horizontalLayout->addWidget(maximize_button_);
-	horizontalLayout->addWidget(close_Button_);
-
-	auto verticalLayout = new QVBoxLayout();
-	verticalLayout->setAlignment(Qt::AlignTop);
-	verticalLayout->setSpacing(0);
-	verticalLayout->setMargin(0);
-
-	//Add the window title bar in the first layout in vertical.
-	verticalLayout->addWidget(title_bar_widget_, 0, Qt::AlignTop);
-
-	//Add the window content here.
-	auto winHost = new Designer;
-	verticalLayout->addWidget(winHost, 1);
-
-	//Add an central widget of this window.
-	m_centralWidget = new QWidget(this);
-	m_centralWidget->setObjectName("centralWidget");
-	m_centralWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-	m_centralWidget->setLayout(verticalLayout);
-	m_centralWidget->setContentsMargins(0, 0, 0, 0);
-	setCentralWidget(m_centralWidget);
-}
-
-bool Studio::Softer::Windows::Window::nativeEvent(const QByteArray& eventType, void* message, long* result)
-{
-	Q_UNUSED(eventType);
-
-	auto msg = static_cast<MSG *>(message);
-
-	switch (msg->message)
-	{
-	case WM_NCCREATE: {
-		auto userdata = reinterpret_cast<CREATESTRUCTW*>(msg->lParam)->lpCreateParams;
-		// store window instance pointer in window user data
-		::SetWindowLongPtrW(msg->hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(userdata));
-	}
-
-	case WM_ERASEBKGND:
-	{
-		auto brush = CreateSolidBrush(RGB(48, 48, 48));
-		SetClassLongPtr(msg->hwnd, GCLP_HBRBACKGROUND, reinterpret_cast<LONG_PTR>(brush));
-	}
-
-	case WM_NCCALCSIZE: {
-		if (msg->wParam == TRUE) {
-			auto& params = *reinterpret_cast<NCCALCSIZE_PARAMS*>(msg->lParam);
-			adjust_maximized_client_rect(msg->hwnd, params.rgrc[0]);
-		}
-		*result = 0;
-		return true;
-	}
-
-	case WM_NCHITTEST: {
-		*result = 0;
-		const LONG border_width = 8; //in pixels
-		RECT winrect;
-		GetWindowRect(reinterpret_cast<HWND>(winId()), &winrect);
-
-		long x = GET_X_LPARAM(msg->lParam);
-		long y = GET_Y_LPARAM(msg->lParam);
-
-		auto resizeWidth = minimumWidth() != maximumWidth();
-		auto resizeHeight = minimumHeight() != maximumHeight();
-
-		if (resizeWidth)
-		{
-			//left border
-			if (x >= winrect.left && x < winrect.left + border_width)
-			{
-				*result = HTLEFT;
-			}
-			//right border
-			if (x < winrect.right && x >= winrect.right - border_width)
-			{
-				*result = HTRIGHT;
-			}
-		}
-		if (resizeHeight)
-		{
-			//bottom border
-			if (y < winrect.bottom && y >= winrect.bottom - border_width)
-			{
-				*result = HTBOTTOM;
-			}
-			//top border
-			if (y >= winrect.top && y < winrect.top + border_width)
-			{
-				*result = HTTOP;
-			}
-		}
-		if (resizeWidth && resizeHeight)
-		{
-			//bottom left corner
-			if (x >= winrect.left && x < winrect.left + border_width &&
-				y < winrect.bottom && y >= winrect.bottom - border_width)
-			{
-				*result = HTBOTTOMLEFT;
-			}
-			//bottom right corner
-			if (x < winrect.right && x >= winrect.right - border_width &&
-				y < winrect.bottom && y >= winrect.bottom - border_width)
-			{
-				*result = HTBOTTOMRIGHT;
-			}
-			//top left corner
-			if (x >= winrect.left && x < winrect.left + border_width &&
-				y >= winrect.top && y < winrect.top + border_width)
-			{
-				*result = HTTOPLEFT;
-			}
-			//top right corner
-			if (x < winrect.right && x >= winrect.right - border_width &&
-				y >= winrect.top && y < winrect.top + border_width)
-			{
-				*result = HTTOPRIGHT;
-			}
-		}
-
-		if (*result != 0)
-			return true;
-
-		auto action = QApplication::widgetAt(QCursor::pos());
-		if (action == title_bar_widget_) {
-			*result = HTCAPTION;
-			return true;
-		}
-		break;
-	}
-
-	case WM_GETMINMAXINFO: {
-		MINMAXINFO* mmi = reinterpret_cast<MINMAXINFO*>(msg->lParam);
-
-		if (maximized(msg->hwnd)) {
-
-			RECT window_rect;
-
-			if (!GetWindowRect(msg->hwnd, &window_rect)) {
-				return false;
-
-			}
-
-			HMONITOR monitor = MonitorFromRect(&window_rect, MONITOR_DEFAULTTONULL);
-			if (!monitor) {
-				return false;
-			}
-
-			MONITORINFO monitor_info = { 0 };
-			monitor_info.cbSize = sizeof(monitor_info);
-			GetMonitorInfo(monitor, &monitor_info);
-
-			RECT work_area = monitor_info.rcWork;
-			RECT monitor_rect = monitor_info.rcMonitor;
-
-			mmi->ptMaxPosition.x = abs(work_area.left - monitor_rect.left);
-			mmi->ptMaxPosition.y = abs(work_area.top - monitor_rect.top);
-			
-			mmi->ptMaxSize.x = abs(work_area.right - work_area.left);
-			mmi->ptMaxSize.y = abs(work_area.bottom - work_area.top);
-			mmi->ptMaxTrackSize.x = mmi->ptMaxSize.x;
-			mmi->ptMaxTrackSize.y = mmi->ptMaxSize.y;
-
-			*result = 1;
-			return true;
-		}
-	}
-
-	case WM_NCACTIVATE: {
-		if (!composition_enabled()) {
-			// Prevents window frame reappearing on window activation
-			// in "basic" theme, where no aero shadow is present.
-			*result = 1;
-			return true;
-		}
-		break;
-	}
-
-	case WM_SIZE: {
-		RECT winrect;
-		GetClientRect(msg->hwnd, &winrect);
-
-		WINDOWPLACEMENT wp;
-		wp.length = sizeof(WINDOWPLACEMENT);
-		GetWindowPlacement(msg->hwnd, &wp);
-		if (this)
-		{
-			if (wp.showCmd == SW_MAXIMIZE)
-			{
-				::SetWindowPos(reinterpret_cast<HWND>(winId()), Q_NULLPTR, 0, 0, 0, 0, SWP_FRAMECHANGED | SWP_NOMOVE | SWP_NOSIZE);
-			}
-		}
-	}
-
-	default: QWidget::nativeEvent(eventType, message, result);
-	}
-
-	return QWidget::nativeEvent(eventType, message, result);
-}
-
-void Studio::Softer::Windows::Window::mousePressEvent(QMouseEvent* event)
-{
-	if (event->button() == Qt::RightButton)
-	{
-		if (icon_button_->underMouse())
-		{
-			auto hMenu = GetSystemMenu(reinterpret_cast<HWND>(winId()), FALSE);
-
-			if (hMenu)
-			{
-				MENUITEMINFO mii;
-				mii.cbSize = sizeof(MENUITEMINFO);
-				mii.fMask = MIIM_STATE;
-				mii.fType = 0;
-
-				// update the options
-				mii.fState = MF_ENABLED;
-				SetMenuItemInfo(hMenu, SC_RESTORE, FALSE, &mii);
-				SetMenuItemInfo(hMenu, SC_SIZE, FALSE, &mii);
-				SetMenuItemInfo(hMenu, SC_MOVE, FALSE, &mii);
-				SetMenuItemInfo(hMenu, SC_MAXIMIZE, FALSE, &mii);
-				SetMenuItemInfo(hMenu, SC_MINIMIZE, FALSE, &mii);
-
-				mii.fState = MF_GRAYED;
-
-				WINDOWPLACEMENT wp;
-				GetWindowPlacement(reinterpret_cast<HWND>(winId()), &wp);
-
-				switch (wp.showCmd)
-				{
-				case SW_SHOWMAXIMIZED:
-					SetMenuItemInfo(hMenu, SC_SIZE, FALSE, &mii);
-					SetMenuItemInfo(hMenu, SC_MOVE, FALSE, &mii);
-					SetMenuItemInfo(hMenu, SC_MAXIMIZE, FALSE, &mii);
-					SetMenuDefaultItem(hMenu, SC_CLOSE, FALSE);
-					break;
-				case SW_SHOWMINIMIZED:
-					SetMenuItemInfo(hMenu, SC_MINIMIZE, FALSE, &mii);
-					SetMenuDefaultItem(hMenu, SC_RESTORE, FALSE);
-					break;
-				case SW_SHOWNORMAL:
-					SetMenuItemInfo(hMenu, SC_RESTORE, FALSE, &mii);
-					SetMenuDefaultItem(hMenu, SC_CLOSE, FALSE);
-					break;
-				default:;
-				}
-
-				POINT p;
-				if (GetCursorPos(&p))
-				{
-					LPARAM cmd = TrackPopupMenu(hMenu, (TPM_RIGHTBUTTON | TPM_NONOTIFY | TPM_RETURNCMD),
-						p.x, p.y, NULL, reinterpret_cast<HWND>(winId()), Q_NULLPTR);
-
-					if (cmd) PostMessage(reinterpret_cast<HWND>(winId()), WM_SYSCOMMAND, cmd, 0);
-				}
-			}
-		}
-	}
-}
-
-void Studio::Softer::Windows::Window::changeEvent(QEvent* e)
-{
-	QWidget::changeEvent(e);
-
-	if (e->type() == QEvent::WindowStateChange)
-	{
-		auto ev = static_cast<QWindowStateChangeEvent*>(e);
-
-		if (!(ev->oldState() & Qt::WindowMaximized) && windowState() & Qt::WindowMaximized)
-		{
-			restore_button_->setVisible(true);
-			maximize_button_->setVisible(false);
-		}
-		else
-		{
-			restore_button_->setVisible(false);
-			maximize_button_->setVisible(true);
-		}
-	}
-
-	/*if (e->type() == QEvent::ActivationChange)
-	{
-	if (this->isActiveWindow())
-	{
-
-	}
-	else
-	{
-
-	}
-	}*/
-}
-
-void Studio::Softer::Windows::Window::slot_show_system_menu() const
-{
-	auto hMenu = GetSystemMenu(reinterpret_cast<HWND>(winId()), FALSE);
-
-	if (hMenu)
-	{
-		MENUITEMINFO mii;
-		mii.cbSize = sizeof(MENUITEMINFO);
-		mii.fMask = MIIM_STATE;
-		mii.fType = 0;
-
-		// update the options
-		mii.fState = MF_ENABLED;
-		SetMenuItemInfo(hMenu, SC_RESTORE, FALSE, &mii);
-		SetMenuItemInfo(hMenu, SC_SIZE, FALSE, &mii);
-		SetMenuItemInfo(hMenu, SC_MOVE, FALSE, &mii);
-		SetMenuItemInfo(hMenu, SC_MAXIMIZE, FALSE, &mii);
-		SetMenuItemInfo(hMenu, SC_MINIMIZE, FALSE, &mii);
-
-		mii.fState = MF_GRAYED;
-
-		WINDOWPLACEMENT wp;
-		GetWindowPlacement(reinterpret_cast<HWND>(winId()), &wp);
-
-		switch (wp.showCmd)
-		{
-		case SW_SHOWMAXIMIZED:
-			SetMenuItemInfo(hMenu, SC_SIZE, FALSE, &mii);
-			SetMenuItemInfo(hMenu, SC_MOVE, FALSE, &mii);
-			SetMenuItemInfo(hMenu, SC_MAXIMIZE, FALSE, &mii);
-			SetMenuDefaultItem(hMenu, SC_CLOSE, FALSE);
-			break;
-		case SW_SHOWMINIMIZED:
-			SetMenuItemInfo(hMenu, SC_MINIMIZE, FALSE, &mii);
-			SetMenuDefaultItem(hMenu, SC_RESTORE, FALSE);
-			break;
-		case SW_SHOWNORMAL:
-			SetMenuItemInfo(hMenu, SC_RESTORE, FALSE, &mii);
-			SetMenuDefaultItem(hMenu, SC_CLOSE, FALSE);
-			break;
-		default:;
-		}
-
-		RECT winrect;
-		GetWindowRect(reinterpret_cast<HWND>(winId()), &winrect);
-
-		if (windowState() != Qt::WindowMaximized)
-		{
-			LPARAM cmd = TrackPopupMenu(hMenu, (TPM_RIGHTBUTTON | TPM_NONOTIFY | TPM_RETURNCMD),
-				winrect.left, winrect.top + 30, NULL, reinterpret_cast<HWND>(winId()), Q_NULLPTR);
-
-			if (cmd) PostMessage(reinterpret_cast<HWND>(winId()), WM_SYSCOMMAND, cmd, 0);
-		}
-		else
-		{
-			auto monitor = MonitorFromWindow(reinterpret_cast<HWND>(winId()), MONITOR_DEFAULTTONULL);
-			MONITORINFO monitor_info{};
-			monitor_info.cbSize = sizeof(monitor_info);
-			GetMonitorInfoW(monitor, &monitor_info);
-			auto rect = monitor_info.rcWork;
-
-			LPARAM cmd = TrackPopupMenu(hMenu, (TPM_RIGHTBUTTON | TPM_NONOTIFY | TPM_RETURNCMD),
-				rect.left, rect.top + 30, NULL, reinterpret_cast<HWND>(winId()), Q_NULLPTR);
-
-			if (cmd) PostMessage(reinterpret_cast<HWND>(winId()), WM_SYSCOMMAND, cmd, 0);
-		}
-
-	}
-}
-
-void Studio::Softer::Windows::Window::slot_minimized()
-{
-	setWindowState(Qt::WindowMinimized);
-}
-
-void Studio::Softer::Windows::Window::slot_maximized()
-{
-	restore_button_->setVisible(true);
-	maximize_button_->setVisible(false);
-	setWindowState(Qt::WindowMaximized);
-}
-
-void Studio::Softer::Windows::Window::slot_restored()
-{
-	restore_button_->setVisible(false);
-	maximize_button_->setVisible(true);
-	setWindowState(Qt::WindowNoState);
-}
-
-void Studio::Softer::Windows::Window::slot_closed()
-{
-	close();
-}
-
-auto Studio::Softer::Windows::Window::set_borderless(bool enabled) const -> void
-{
-	auto new_style = (enabled) ? select_borderless_style() : Style::windowed;
-	auto old_style = static_cast<Style>(::GetWindowLongPtrW(reinterpret_cast<HWND>(winId()), GWL_STYLE));
-
-	if (new_style != old_style) {
-		::SetWindowLongPtrW(reinterpret_cast<HWND>(winId()), GWL_STYLE, static_cast<LONG>(new_style));
-
-		// redraw frame
-		::SetWindowPos(reinterpret_cast<HWND>(winId()), nullptr, 0, 0, 0, 0, SWP_FRAMECHANGED | SWP_NOMOVE | SWP_NOSIZE);
-	}
-}
-
-void Studio::Softer::Windows::Window::showWindow()
-{
-	setWindowIcon(QIcon(m_appIconPath));
-	icon_button_->setIcon(QIcon(QPixmap(m_appIconPath)));
-
-	QSettings settings(m_orgName, m_appName);
-	restoreGeometry(settings.value("Window/Geometry").toByteArray());
-	restoreState(settings.value("Window/WindowState").toByteArray());
-	
-	show();
-
-	settings.beginGroup("Window/WindowState");
-	if (settings.value("maximized", isMaximized()).toBool())
-	{
-		showNormal();
-		showMaximized();
-	}
-	else
-	{
-		showNormal();
-	}
-	settings.endGroup();
-}
-
-void Studio::Softer::Windows::Window::closeEvent(QCloseEvent* event)
-{
-	QSettings settings(m_orgName, m_appName);
-	settings.setValue("Window/WindowState", saveState());
-	settings.setValue("Window/Geometry", saveGeometry());
-	event->accept();
-}
-
-void Studio::Softer::Windows::Window::setapplicationName(const QString& appName)
-{
-	m_appName = appName;
-}
-
-void Studio::Softer::Windows::Window::setOrganizationName(const QString& orgName)
-{
-	m_orgName = orgName;
-}
-
-void Studio::Softer::Windows::Window::setIcon(const QString& iconPath)
-{
-	m_appIconPath = iconPath;
-}
+#include "Window.h"
+#include "SettingsStore.h"
+#include "NativePaintResources.h"
+#include "IconCache.h"
+#include "ThemeEngine.h"
+
+#include <cmath>
+#include <QLayout>
+#include <QApplication>
+#ifdef Q_OS_WIN
+#include <dwmapi.h>
+#include <windows.h>
+#include <windowsx.h>
+#pragma comment(lib, "dwmapi.lib")
+// Windows 8.1, not defined by the older SDKs
+#ifndef WM_DPICHANGED
+#define WM_DPICHANGED 0x02E0
+#endif
+#endif
+
+namespace {
+#ifdef Q_OS_WIN
+	// we cannot just use WS_POPUP style
+	// WS_THICKFRAME: without this the window cannot be resized and so aero snap, de-maximizing and minimizing won't work
+	// WS_SYSMENU: enables the context menu with the move, close, maximize, minimize... commands (shift + right-click on the task bar item)
+	// WS_CAPTION: enables aero minimize animation/transition
+	// WS_MAXIMIZEBOX, WS_MINIMIZEBOX: enable minimize/maximize
+	enum class Style : DWORD {
+		windowed = WS_OVERLAPPEDWINDOW | WS_THICKFRAME | WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX,
+		aero_borderless = WS_POPUP | WS_THICKFRAME | WS_CAPTION | WS_SYSMENU | WS_MAXIMIZEBOX | WS_MINIMIZEBOX,
+		basic_borderless = WS_POPUP | WS_THICKFRAME | WS_SYSMENU | WS_MAXIMIZEBOX | WS_MINIMIZEBOX
+	};
+
+	auto maximized(HWND hwnd) -> bool {
+		return ::IsZoomed(hwnd) != FALSE;
+	}
+
+	auto to_rect(const QRect& rect) -> RECT {
+		return RECT{ rect.left(), rect.top(), rect.left() + rect.width(), rect.top() + rect.height() };
+	}
+
+	auto to_qrect(const RECT& rect) -> QRect {
+		return QRect(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top);
+	}
+
+	// the cache key of a monitor, see ScreenGeometryCache::geometry
+	auto monitor_key(HMONITOR monitor) -> quintptr {
+		return reinterpret_cast<quintptr>(monitor);
+	}
+
+	auto window_monitor(HWND hwnd) -> quintptr {
+		return monitor_key(::MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST));
+	}
+
+	// the geometry of a monitor, or of the monitor of a window, in device pixels
+	auto native_screen_geometry(QWindow* window, quintptr screen) -> Studio::Softer::Windows::ScreenGeometry {
+		auto monitor = screen ? reinterpret_cast<HMONITOR>(screen)
+			: window ? ::MonitorFromWindow(reinterpret_cast<HWND>(window->winId()), MONITOR_DEFAULTTONEAREST)
+			: ::MonitorFromPoint(POINT{ 0, 0 }, MONITOR_DEFAULTTOPRIMARY);
+
+		MONITORINFO monitor_info{};
+		monitor_info.cbSize = sizeof(monitor_info);
+		if (!::GetMonitorInfoW(monitor, &monitor_info)) {
+			return Studio::Softer::Windows::ScreenGeometry{ QRect(), QRect(), 1.0 };
+		}
+
+		return Studio::Softer::Windows::ScreenGeometry{ to_qrect(monitor_info.rcWork), to_qrect(monitor_info.rcMonitor),
+			window ? window->devicePixelRatio() : 1.0 };
+	}
+
+	// the work area of a cached monitor in device independent pixels, Qt keeps the origin of each screen
+	auto logical_work_area(const Studio::Softer::Windows::ScreenGeometry& screen) -> QRect {
+		auto origin = screen.screenRect.topLeft();
+		auto ratio = screen.devicePixelRatio > 0 ? screen.devicePixelRatio : 1.0;
+		return QRect(origin + (screen.workArea.topLeft() - origin) / ratio, screen.workArea.size() / ratio);
+	}
+
+	/* Adjust client rect to not spill over monitor edges when maximized.
+	* rect(in/out): in: proposed window rect, out: calculated client rect
+	* Does nothing if the window is not maximized.
+	*/
+	auto adjust_maximized_client_rect(HWND window, const QRect& work_area, RECT& rect) -> void {
+		if (!maximized(window) || work_area.isEmpty()) {
+			return;
+		}
+
+		// when maximized, make the client area fill just the monitor (without task bar) rect,
+		// not the whole window rect which extends beyond the monitor.
+		rect = to_rect(work_area);
+	}
+
+	auto composition_enabled() -> bool {
+		auto composition_enabled = FALSE;
+		auto success = ::DwmIsCompositionEnabled(&composition_enabled) == S_OK;
+		return composition_enabled && success;
+	}
+
+	auto select_borderless_style() -> Style {
+		return composition_enabled() ? Style::aero_borderless : Style::basic_borderless;
+	}
+
+	// the brushes are shared by the windows, they all use the same window class
+	auto paint_resources() -> Studio::Softer::Windows::NativePaintResources& {
+		static Studio::Softer::Windows::NativePaintResources resources(
+			[](QRgb color) -> void * { return ::CreateSolidBrush(RGB(qRed(color), qGreen(color), qBlue(color))); },
+			[](void *brush) { ::DeleteObject(static_cast<HBRUSH>(brush)); });
+		return resources;
+	}
+
+	auto to_hit_test(Studio::Softer::Windows::HitTestMap::Region region) -> LRESULT {
+		using Studio::Softer::Windows::HitTestMap;
+		switch (region) {
+		case HitTestMap::Caption: return HTCAPTION;
+		case HitTestMap::Left: return HTLEFT;
+		case HitTestMap::Right: return HTRIGHT;
+		case HitTestMap::Top: return HTTOP;
+		case HitTestMap::Bottom: return HTBOTTOM;
+		case HitTestMap::TopLeft: return HTTOPLEFT;
+		case HitTestMap::TopRight: return HTTOPRIGHT;
+		case HitTestMap::BottomLeft: return HTBOTTOMLEFT;
+		case HitTestMap::BottomRight: return HTBOTTOMRIGHT;
+		default: return HTCLIENT;
+		}
+	}
+
+#else
+	// the compositor moves or resizes the window from these edges
+	auto to_edges(Studio::Softer::Windows::HitTestMap::Region region) -> Qt::Edges {
+		using Studio::Softer::Windows::HitTestMap;
+		switch (region) {
+		case HitTestMap::Left: return Qt::LeftEdge;
+		case HitTestMap::Right: return Qt::RightEdge;
+		case HitTestMap::Top: return Qt::TopEdge;
+		case HitTestMap::Bottom: return Qt::BottomEdge;
+		case HitTestMap::TopLeft: return Qt::TopEdge | Qt::LeftEdge;
+		case HitTestMap::TopRight: return Qt::TopEdge | Qt::RightEdge;
+		case HitTestMap::BottomLeft: return Qt::BottomEdge | Qt::LeftEdge;
+		case HitTestMap::BottomRight: return Qt::BottomEdge | Qt::RightEdge;
+		default: return Qt::Edges();
+		}
+	}
+
+	auto to_cursor(Studio::Softer::Windows::HitTestMap::Region region) -> Qt::CursorShape {
+		using Studio::Softer::Windows::HitTestMap;
+		switch (region) {
+		case HitTestMap::Left:
+		case HitTestMap::Right: return Qt::SizeHorCursor;
+		case HitTestMap::Top:
+		case HitTestMap::Bottom: return Qt::SizeVerCursor;
+		case HitTestMap::TopLeft:
+		case HitTestMap::BottomRight: return Qt::SizeFDiagCursor;
+		case HitTestMap::TopRight:
+		case HitTestMap::BottomLeft: return Qt::SizeBDiagCursor;
+		default: return Qt::ArrowCursor;
+		}
+	}
+#endif
+
+	const quint32 snapshotMagic = 0x534e4150; // "SNAP"
+	const quint16 snapshotVersion = 1;
+
+	/* Everything needed to build the window at its final size on the next launch:
+	* the geometry, the maximized state, the dock and toolbar layout of the content
+	* and the hash of the theme they were laid out with.
+	*/
+	struct Snapshot {
+		QByteArray geometry;
+		bool maximized = false;
+		QByteArray windowState;
+		QByteArray contentState;
+		QByteArray themeHash;
+	};
+
+	auto write_snapshot(const Snapshot& snapshot) -> QByteArray {
+		QByteArray data;
+		QDataStream stream(&data, QIODevice::WriteOnly);
+		stream.setVersion(QDataStream::Qt_5_6);
+		stream << snapshotMagic << snapshotVersion << snapshot.geometry << snapshot.maximized
+			<< snapshot.windowState << snapshot.contentState << snapshot.themeHash;
+		return data;
+	}
+
+	// false when the blob is missing, from another version or corrupted
+	auto read_snapshot(const QByteArray& data, Snapshot& snapshot) -> bool {
+		QDataStream stream(data);
+		stream.setVersion(QDataStream::Qt_5_6);
+
+		quint32 magic = 0;
+		quint16 version = 0;
+		stream >> magic >> version;
+		if (magic != snapshotMagic || version != snapshotVersion) {
+			return false;
+		}
+
+		stream >> snapshot.geometry >> snapshot.maximized
+			>> snapshot.windowState >> snapshot.contentState >> snapshot.themeHash;
+		return stream.status() == QDataStream::Ok;
+	}
+}
+
+Studio::Softer::Windows::Window::Window(QMenuBar *menuBar, QWidget *content)
+	: minimize_button_(Q_NULLPTR), maximize_button_(Q_NULLPTR), restore_button_(Q_NULLPTR),
+	close_Button_(Q_NULLPTR), title_bar_widget_(Q_NULLPTR), icon_button_(Q_NULLPTR),
+	m_systemMenuRevision(0), m_systemMenuPopup(Q_NULLPTR),
+	m_contentHost(Q_NULLPTR), m_shellVisibleTime(-1), m_contentReadyTime(-1), m_layoutPasses(0),
+	m_backgroundColor(48, 48, 48), m_titleBarBorderWidth(0), m_frameMaximized(false), m_manualMove(false), m_movePending(false), m_cursorRegion(HitTestMap::Client)
+{
+	create_shell(menuBar);
+
+	//The content is created now, an empty placeholder when no product content is given,
+	//the products are loaded by Studio.Softer from their own modules.
+	m_contentHost->setContent(content ? content : new QWidget);
+}
+
+// the content is created by the factory once the window shell has been painted
+Studio::Softer::Windows::Window::Window(QMenuBar *menuBar, const ContentHost::ContentFactory &factory)
+	: minimize_button_(Q_NULLPTR), maximize_button_(Q_NULLPTR), restore_button_(Q_NULLPTR),
+	close_Button_(Q_NULLPTR), title_bar_widget_(Q_NULLPTR), icon_button_(Q_NULLPTR),
+	m_systemMenuRevision(0), m_systemMenuPopup(Q_NULLPTR),
+	m_contentHost(Q_NULLPTR), m_shellVisibleTime(-1), m_contentReadyTime(-1), m_layoutPasses(0),
+	m_backgroundColor(48, 48, 48), m_titleBarBorderWidth(0), m_frameMaximized(false), m_manualMove(false), m_movePending(false), m_cursorRegion(HitTestMap::Client)
+{
+	create_shell(menuBar);
+
+	if (factory)
+		m_contentHost->setContentFactory(factory);
+	else
+		m_contentHost->setContentFactory([](QWidget *parent) -> QWidget * { return new QWidget(parent); });
+}
+
+auto Studio::Softer::Windows::Window::create_shell(QMenuBar *menuBar) -> void
+{
+	m_clock.start();
+
+#ifdef Q_OS_WIN
+	// the monitor geometry is read from Win32, in device pixels, and kept until a screen changes
+	m_screenCache.setProvider(native_screen_geometry);
+#endif
+
+	setWindowFlags(Qt::FramelessWindowHint);
+	set_borderless(true);
+
+	m_screenCache.attach(windowHandle());
+	connect(windowHandle(), &QWindow::screenChanged, this, [this]()
+	{
+		update_metrics();
+		m_hitTestMap.invalidate();
+	});
+	m_systemMenu.update(windowState());
+	update_metrics();
+#ifndef Q_OS_WIN
+	// the moves and resizes are handed to the compositor, see handle_frame_event
+	windowHandle()->installEventFilter(this);
+#endif
+
+	// set black background
+	auto pal = palette();
+	pal.setColor(QPalette::Background, Qt::black);
+	setAutoFillBackground(true);
+	setPalette(pal);
+	setBackgroundRole(QPalette::Dark);
+
+	auto horizontalLayout = new QHBoxLayout();
+	horizontalLayout->setSpacing(0);
+	horizontalLayout->setMargin(0);
+
+	//Represent the window title bar.
+	title_bar_widget_ = new QWidget(this);
+	title_bar_widget_->setFixedHeight(m_metrics.titleBarHeight());
+	title_bar_widget_->setObjectName("windowTitleBar");
+	title_bar_widget_->setContentsMargins(0, 0, 0, 0);
+	title_bar_widget_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+	title_bar_widget_->setLayout(horizontalLayout);
+	title_bar_widget_->installEventFilter(this);
+
+	icon_button_ = new CaptionButton(title_bar_widget_);
+	icon_button_->setIconSize(m_metrics.windowIconSize());
+	icon_button_->setContentsMargins(m_metrics.windowIconMargin(), 0, 0, 0);
+	icon_button_->setObjectName("titleBarIcon");
+	connect(icon_button_, SIGNAL(clicked()), this, SLOT(slot_show_system_menu()));
+
+	//Represent the minimize button.
+	minimize_button_ = new CaptionButton(title_bar_widget_);
+	minimize_button_->setFixedSize(m_metrics.captionButtonSize());
+	minimize_button_->setIconPath(":/Icons/IconsCommand/Minimize.png");
+	minimize_button_->setIconSize(m_metrics.captionIconSize());
+	minimize_button_->setObjectName("minimizeButton");
+	minimize_button_->setToolTip(tr("Minimize"));
+	connect(minimize_button_, SIGNAL(clicked()), this, SLOT(slot_minimized()));
+
+	//Represent the maximize button.
+	maximize_button_ = new CaptionButton(title_bar_widget_);
+	maximize_button_->setFixedSize(m_metrics.captionButtonSize());
+	maximize_button_->setIconPath(":/Icons/IconsCommand/Maximize.png");
+	maximize_button_->setIconSize(m_metrics.captionIconSize());
+	maximize_button_->setObjectName("maximizeButton");
+	maximize_button_->setToolTip(tr("Maximize"));
+	maximize_button_->setVisible(true);
+	connect(maximize_button_, SIGNAL(clicked()), this, SLOT(slot_maximized()));
+
+	//Represent the restore button.
+	restore_button_ = new CaptionButton(title_bar_widget_);
+	restore_button_->setFixedSize(m_metrics.captionButtonSize());
+	restore_button_->setIconPath(":/Icons/IconsCommand/Restore.png");
+	restore_button_->setIconSize(m_metrics.captionIconSize());
+	restore_button_->setObjectName("restoreButton");
+	restore_button_->setToolTip(tr("Restore"));
+	restore_button_->setVisible(false);
+	connect(restore_button_, SIGNAL(clicked()), this, SLOT(slot_restored()));
+
+	//Represent the close button.
+	close_Button_ = new CaptionButton(title_bar_widget_);
+	close_Button_->setFixedSize(m_metrics.captionButtonSize());
+	close_Button_->setIconPath(":/Icons/IconsCommand/Close.png");
+	close_Button_->setIconSize(m_metrics.captionIconSize());
+	close_Button_->setObjectName("closeButton");
+	close_Button_->setToolTip(tr("Close"));
+	connect(close_Button_, SIGNAL(clicked()), this, SLOT(slot_closed()));
+
+	//The colours of the frame follow the theme, a switch only updates the buttons and the background brush.
+	//The title bar and the caption buttons paint the native rules of the stylesheet, see ThemeEngine::styleColor.
+	auto &themes = ThemeEngine::instance();
+	themes.bind(this, { ThemeEngine::WindowBackground }, [this]()
+	{
+		setBackgroundColor(ThemeEngine::instance().color(ThemeEngine::WindowBackground));
+	});
+	themes.bind(title_bar_widget_, themes.styleTokens("windowTitleBar", { ThemeEngine::TitleBarBackground, ThemeEngine::Border }), [this]()
+	{
+		auto &themes = ThemeEngine::instance();
+		m_titleBarColor = themes.styleColor("windowTitleBar", "", "background-color", themes.color(ThemeEngine::TitleBarBackground));
+		m_titleBarBorderColor = themes.styleColor("windowTitleBar", "", "border-bottom-color", themes.color(ThemeEngine::Border));
+		m_titleBarBorderWidth = themes.styleMetric("windowTitleBar", "", "border-bottom-width", 1);
+		title_bar_widget_->update();
+	});
+	for (auto button : { minimize_button_, maximize_button_, restore_button_, close_Button_ })
+	{
+		themes.bind(button, themes.styleTokens("CaptionButton", { ThemeEngine::CaptionHover, ThemeEngine::CaptionPressed }), [button]()
+		{
+			auto &themes = ThemeEngine::instance();
+			button->setColors(themes.styleColor("CaptionButton", "hover", "background-color", themes.color(ThemeEngine::CaptionHover)),
+				themes.styleColor("CaptionButton", "pressed", "background-color", themes.color(ThemeEngine::CaptionPressed)));
+		});
+	}
+	themes.bind(icon_button_, themes.styleTokens("titleBarIcon", QVector<ThemeEngine::Token>()), [this]()
+	{
+		auto &themes = ThemeEngine::instance();
+		icon_button_->setColors(themes.styleColor("titleBarIcon", "hover", "background-color", Qt::transparent),
+			themes.styleColor("titleBarIcon", "pressed", "background-color", Qt::transparent));
+	});
+
+	//Add icon on the title bar.
+	horizontalLayout->addWidget(icon_button_);
+
+	//Add a menu bar on the window title bar.
+	if (menuBar) horizontalLayout->addWidget(menuBar);
+
+	//Add space beetwen the menubar and command icon
+	horizontalLayout->addStretch(1);
+
+	//Add button command.
+	horizontalLayout->addWidget(minimize_button_);
+	horizontalLayout->addWidget(restore_button_);
+	horizontalLayout->addWidget(maximize_button_);
+	horizontalLayout->addWidget(close_Button_);
+
+	auto verticalLayout = new QVBoxLayout();
+	verticalLayout->setAlignment(Qt::AlignTop);
+	verticalLayout->setSpacing(0);
+	verticalLayout->setMargin(0);
+
+	//Add the window title bar in the first layout in vertical.
+	verticalLayout->addWidget(title_bar_widget_, 0, Qt::AlignTop);
+
+	//Add the host of the window content, it paints the background until the content exists.
+	m_contentHost = new ContentHost;
+	m_contentHost->setFirstPaintHandler([this]()
+	{
+		m_shellVisibleTime = m_clock.elapsed();
+		emit shellVisible();
+	});
+	m_contentHost->setContentReadyHandler([this]()
+	{
+		// the layout passes of the content are counted with the ones of the window
+		m_contentHost->content()->installEventFilter(this);
+		restore_content_state();
+		m_contentReadyTime = m_clock.elapsed();
+		emit contentReady();
+	});
+	verticalLayout->addWidget(m_contentHost, 1);
+
+	//Add an central widget of this window.
+	m_centralWidget = new QWidget(this);
+	m_centralWidget->setObjectName("centralWidget");
+	m_centralWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+	m_centralWidget->setLayout(verticalLayout);
+	m_centralWidget->setContentsMargins(0, 0, 0, 0);
+	setCentralWidget(m_centralWidget);
+}
+
+bool Studio::Softer::Windows::Window::event(QEvent* event)
+{
+	switch (event->type())
+	{
+	case QEvent::LayoutRequest:
+		++m_layoutPasses;
+		m_hitTestMap.invalidate();
+		break;
+	case QEvent::Resize:
+	case QEvent::WindowStateChange:
+		m_hitTestMap.invalidate();
+		break;
+	case QEvent::ScreenChangeInternal:
+		// another screen or another ratio of the same one, ie: the scale of the monitor changed
+		update_metrics();
+		break;
+	default:;
+	}
+
+	return QMainWindow::event(event);
+}
+
+bool Studio::Softer::Windows::Window::eventFilter(QObject* watched, QEvent* event)
+{
+	if (watched == windowHandle() && handle_frame_event(event))
+		return true;
+
+	if (event->type() == QEvent::LayoutRequest && m_contentHost && watched == m_contentHost->content())
+		++m_layoutPasses;
+
+	// the buttons and the menu bar of the title bar moved
+	if (watched == title_bar_widget_ && (event->type() == QEvent::LayoutRequest || event->type() == QEvent::Resize))
+		m_hitTestMap.invalidate();
+
+	// the background and the bottom border of the native rule of the title bar, Qt paints its children
+	if (watched == title_bar_widget_ && event->type() == QEvent::Paint)
+	{
+		QPainter painter(title_bar_widget_);
+		auto rect = title_bar_widget_->rect();
+		painter.fillRect(rect, m_titleBarColor);
+		if (m_titleBarBorderWidth > 0)
+			painter.fillRect(QRect(rect.left(), rect.bottom() - m_titleBarBorderWidth + 1, rect.width(), m_titleBarBorderWidth), m_titleBarBorderColor);
+	}
+
+	return QMainWindow::eventFilter(watched, event);
+}
+
+bool Studio::Softer::Windows::Window::nativeEvent(const QByteArray& eventType, void* message, long* result)
+{
+#ifdef Q_OS_WIN
+	Q_UNUSED(eventType);
+
+	auto msg = static_cast<MSG *>(message);
+
+	switch (msg->message)
+	{
+	case WM_NCCREATE: {
+		auto userdata = reinterpret_cast<CREATESTRUCTW*>(msg->lParam)->lpCreateParams;
+		// store window instance pointer in window user data
+		::SetWindowLongPtrW(msg->hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(userdata));
+		break;
+	}
+
+	case WM_NCCALCSIZE: {
+		if (msg->wParam == TRUE) {
+			// the proposed rect may already be on another monitor, ie: a snap, Qt has not moved the window yet
+			auto& params = *reinterpret_cast<NCCALCSIZE_PARAMS*>(msg->lParam);
+			auto monitor = monitor_key(::MonitorFromRect(&params.rgrc[0], MONITOR_DEFAULTTONEAREST));
+			adjust_maximized_client_rect(msg->hwnd, m_screenCache.geometry(monitor).workArea, params.rgrc[0]);
+		}
+		*result = 0;
+		return true;
+	}
+
+	case WM_NCHITTEST: {
+		// the regions are only computed again after a resize or a layout change
+		if (!m_hitTestMap.isValid()) update_hit_test_map();
+
+		POINT point{ GET_X_LPARAM(msg->lParam), GET_Y_LPARAM(msg->lParam) };
+		::ScreenToClient(msg->hwnd, &point);
+
+		auto region = m_hitTestMap.hitTest(QPoint(point.x, point.y));
+		if (region == HitTestMap::Client)
+			break;
+
+		*result = to_hit_test(region);
+		return true;
+	}
+
+	case WM_GETMINMAXINFO: {
+		MINMAXINFO* mmi = reinterpret_cast<MINMAXINFO*>(msg->lParam);
+
+		if (maximized(msg->hwnd)) {
+			const auto &screen = m_screenCache.geometry(window_monitor(msg->hwnd));
+			if (screen.workArea.isEmpty()) {
+				return false;
+			}
+
+			const auto &work_area = screen.workArea;
+			const auto &monitor_rect = screen.screenRect;
+
+			mmi->ptMaxPosition.x = abs(work_area.left() - monitor_rect.left());
+			mmi->ptMaxPosition.y = abs(work_area.top() - monitor_rect.top());
+			
+			mmi->ptMaxSize.x = work_area.width();
+			mmi->ptMaxSize.y = work_area.height();
+			mmi->ptMaxTrackSize.x = mmi->ptMaxSize.x;
+			mmi->ptMaxTrackSize.y = mmi->ptMaxSize.y;
+
+			*result = 1;
+			return true;
+		}
+		break;
+	}
+
+	case WM_NCACTIVATE: {
+		if (!composition_enabled()) {
+			// Prevents window frame reappearing on window activation
+			// in "basic" theme, where no aero shadow is present.
+			*result = 1;
+			return true;
+		}
+		break;
+	}
+
+	case WM_SIZE: {
+		// the frame is only recomputed when the window becomes maximized, not for each size of a drag
+		if (msg->wParam == SIZE_MINIMIZED) break;
+
+		auto wasMaximized = m_frameMaximized;
+		m_frameMaximized = msg->wParam == SIZE_MAXIMIZED;
+		if (m_frameMaximized && !wasMaximized)
+		{
+			::SetWindowPos(msg->hwnd, Q_NULLPTR, 0, 0, 0, 0, SWP_FRAMECHANGED | SWP_NOMOVE | SWP_NOSIZE);
+		}
+		break;
+	}
+
+	case WM_ENTERSIZEMOVE: {
+		m_contentHost->beginLiveResize();
+		break;
+	}
+
+	case WM_EXITSIZEMOVE: {
+		m_contentHost->endLiveResize();
+		break;
+	}
+
+	case WM_DPICHANGED: {
+		// the same monitor, its geometry is now given at another scale
+		m_screenCache.invalidate();
+		break;
+	}
+
+	default: break;
+	}
+#endif
+
+	return QWidget::nativeEvent(eventType, message, result);
+}
+
+void Studio::Softer::Windows::Window::mousePressEvent(QMouseEvent* event)
+{
+	if (event->button() != Qt::RightButton || !icon_button_->underMouse())
+		return;
+
+#ifdef Q_OS_WIN
+	POINT p;
+	if (GetCursorPos(&p))
+		show_system_menu(QPoint(p.x, p.y));
+#else
+	show_system_menu(event->globalPos());
+#endif
+}
+
+void Studio::Softer::Windows::Window::changeEvent(QEvent* e)
+{
+	QWidget::changeEvent(e);
+
+	if (e->type() == QEvent::WindowStateChange)
+	{
+		auto ev = static_cast<QWindowStateChangeEvent*>(e);
+		m_systemMenu.update(windowState());
+
+		if (!(ev->oldState() & Qt::WindowMaximized) && windowState() & Qt::WindowMaximized)
+		{
+			restore_button_->setVisible(true);
+			maximize_button_->setVisible(false);
+		}
+		else
+		{
+			restore_button_->setVisible(false);
+			maximize_button_->setVisible(true);
+		}
+	}
+
+	/*if (e->type() == QEvent::ActivationChange)
+	{
+	if (this->isActiveWindow())
+	{
+
+	}
+	else
+	{
+
+	}
+	}*/
+}
+
+void Studio::Softer::Windows::Window::slot_show_system_menu()
+{
+	// below the title bar icon, or the top of the screen when maximized
+#ifdef Q_OS_WIN
+	RECT winrect;
+	GetWindowRect(reinterpret_cast<HWND>(winId()), &winrect);
+
+	auto origin = windowState() != Qt::WindowMaximized ? QPoint(winrect.left, winrect.top)
+		: m_screenCache.geometry(window_monitor(reinterpret_cast<HWND>(winId()))).workArea.topLeft();
+	show_system_menu(origin + QPoint(0, m_metrics.menuOffset()));
+#else
+	show_system_menu(title_bar_widget_->mapToGlobal(title_bar_widget_->rect().bottomLeft()));
+#endif
+}
+
+void Studio::Softer::Windows::Window::slot_minimized()
+{
+	change_window_state(Qt::WindowMinimized, [this]()
+	{
+		setWindowState(Qt::WindowMinimized);
+	});
+}
+
+void Studio::Softer::Windows::Window::slot_maximized()
+{
+	change_window_state(Qt::WindowMaximized, [this]()
+	{
+		restore_button_->setVisible(true);
+		maximize_button_->setVisible(false);
+		setWindowState(Qt::WindowMaximized);
+	});
+}
+
+void Studio::Softer::Windows::Window::slot_restored()
+{
+	change_window_state(Qt::WindowNoState, [this]()
+	{
+		restore_button_->setVisible(false);
+		maximize_button_->setVisible(true);
+		setWindowState(Qt::WindowNoState);
+	});
+}
+
+// the menu is rendered again only when the window state changed since it was last shown,
+// the position is in the coordinates of the platform, device pixels on Windows
+auto Studio::Softer::Windows::Window::show_system_menu(const QPoint& position) -> void
+{
+#ifdef Q_OS_WIN
+	auto hwnd = reinterpret_cast<HWND>(winId());
+	auto hMenu = GetSystemMenu(hwnd, FALSE);
+	if (!hMenu) return;
+
+	if (m_systemMenuRevision != m_systemMenu.revision())
+	{
+		m_systemMenu.render(hMenu);
+		m_systemMenuRevision = m_systemMenu.revision();
+	}
+
+	LPARAM cmd = TrackPopupMenu(hMenu, (TPM_RIGHTBUTTON | TPM_NONOTIFY | TPM_RETURNCMD),
+		position.x(), position.y(), NULL, hwnd, Q_NULLPTR);
+
+	if (cmd) PostMessage(hwnd, WM_SYSCOMMAND, cmd, 0);
+#else
+	if (!m_systemMenuPopup)
+		m_systemMenuPopup = new QMenu(this);
+
+	if (m_systemMenuRevision != m_systemMenu.revision())
+	{
+		m_systemMenu.render(m_systemMenuPopup);
+		m_systemMenuRevision = m_systemMenu.revision();
+	}
+
+	if (auto action = m_systemMenuPopup->exec(position))
+		run_system_command(static_cast<SystemMenuModel::Command>(action->data().toInt()));
+#endif
+}
+
+// the commands of the Qt system menu, Windows runs its own from WM_SYSCOMMAND
+auto Studio::Softer::Windows::Window::run_system_command(SystemMenuModel::Command command) -> void
+{
+	switch (command)
+	{
+	case SystemMenuModel::Restore: slot_restored(); break;
+	case SystemMenuModel::Minimize: slot_minimized(); break;
+	case SystemMenuModel::Maximize: slot_maximized(); break;
+	case SystemMenuModel::Close: slot_closed(); break;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	case SystemMenuModel::Move: windowHandle()->startSystemMove(); break;
+	case SystemMenuModel::Size: windowHandle()->startSystemResize(Qt::RightEdge | Qt::BottomEdge); break;
+#endif
+	default: break;
+	}
+}
+
+// the state is applied at once, or at the end of its transition when the animations are enabled
+auto Studio::Softer::Windows::Window::change_window_state(Qt::WindowState state, const std::function<void()>& apply) -> void
+{
+	if (!m_stateAnimator.isEnabled() || !isVisible())
+	{
+		apply();
+		return;
+	}
+
+	auto from = frameGeometry();
+#ifdef Q_OS_WIN
+	// the monitor the min/max messages asked for, the cache holds it in device pixels
+	auto workArea = logical_work_area(m_screenCache.geometry(window_monitor(reinterpret_cast<HWND>(winId()))));
+#else
+	auto workArea = m_screenCache.geometry().workArea;
+#endif
+
+	QRect to;
+	switch (state)
+	{
+	case Qt::WindowMaximized:
+		to = workArea;
+		break;
+	case Qt::WindowMinimized:
+		// towards the task bar
+		to = QRect(0, 0, from.width() / 4, from.height() / 4);
+		to.moveCenter(QPoint(from.center().x(), workArea.bottom()));
+		break;
+	default:
+		to = normalGeometry().isValid() ? normalGeometry() : geometry();
+		break;
+	}
+
+	m_stateAnimator.animate(this, from, to, apply);
+}
+
+void Studio::Softer::Windows::Window::setStateAnimationEnabled(bool enabled)
+{
+	m_stateAnimator.setEnabled(enabled);
+}
+
+const Studio::Softer::Windows::WindowStateAnimator& Studio::Softer::Windows::Window::stateAnimator() const
+{
+	return m_stateAnimator;
+}
+
+void Studio::Softer::Windows::Window::slot_closed()
+{
+	close();
+}
+
+auto Studio::Softer::Windows::Window::set_borderless(bool enabled) const -> void
+{
+#ifdef Q_OS_WIN
+	auto new_style = (enabled) ? select_borderless_style() : Style::windowed;
+	auto old_style = static_cast<Style>(::GetWindowLongPtrW(reinterpret_cast<HWND>(winId()), GWL_STYLE));
+
+	if (new_style != old_style) {
+		::SetWindowLongPtrW(reinterpret_cast<HWND>(winId()), GWL_STYLE, static_cast<LONG>(new_style));
+
+		// redraw frame
+		::SetWindowPos(reinterpret_cast<HWND>(winId()), nullptr, 0, 0, 0, 0, SWP_FRAMECHANGED | SWP_NOMOVE | SWP_NOSIZE);
+	}
+#else
+	// Qt::FramelessWindowHint is enough, the native window is created for the event filters
+	Q_UNUSED(enabled);
+	winId();
+#endif
+}
+
+void Studio::Softer::Windows::Window::showWindow()
+{
+	// the settings were read in the background, see SettingsStore::load
+	auto &settings = SettingsStore::instance();
+	settings.load(m_orgName, m_appName);
+
+	// the geometry is always restored, the docks and the content only with the theme they were laid out with
+	Snapshot snapshot;
+	if (read_snapshot(settings.value("Window/Snapshot").toByteArray(), snapshot))
+	{
+		restoreGeometry(snapshot.geometry);
+		if (snapshot.themeHash == m_themeHash)
+		{
+			restoreState(snapshot.windowState);
+			m_contentState = snapshot.contentState;
+			restore_content_state();
+		}
+	}
+	else
+	{
+		restoreGeometry(settings.value("Window/Geometry").toByteArray());
+		restoreState(settings.value("Window/WindowState").toByteArray());
+		snapshot.maximized = settings.value("Window/WindowState/maximized", isMaximized()).toBool();
+	}
+
+	// the window is shown once, directly in its final state
+	setWindowState(snapshot.maximized ? windowState() | Qt::WindowMaximized : windowState() & ~Qt::WindowMaximized);
+	show();
+}
+
+void Studio::Softer::Windows::Window::closeEvent(QCloseEvent* event)
+{
+	Snapshot snapshot;
+	snapshot.geometry = saveGeometry();
+	snapshot.maximized = isMaximized();
+	snapshot.windowState = saveState();
+	snapshot.themeHash = m_themeHash;
+
+	// the content may not exist yet, its previous layout is kept
+	auto content = qobject_cast<QMainWindow *>(m_contentHost->content());
+	snapshot.contentState = content ? content->saveState() : m_contentState;
+
+	// written from a background thread, see SettingsStore::sync
+	auto &settings = SettingsStore::instance();
+	settings.setValue("Window/Snapshot", write_snapshot(snapshot));
+	settings.remove("Window/Geometry");
+	settings.remove("Window/WindowState");
+	settings.remove("Window/WindowState/maximized");
+	event->accept();
+}
+
+void Studio::Softer::Windows::Window::setapplicationName(const QString& appName)
+{
+	m_appName = appName;
+}
+
+void Studio::Softer::Windows::Window::setOrganizationName(const QString& orgName)
+{
+	m_orgName = orgName;
+}
+
+void Studio::Softer::Windows::Window::setThemeHash(const QByteArray& themeHash)
+{
+	m_themeHash = themeHash;
+	apply_background_brush();
+}
+
+void Studio::Softer::Windows::Window::setBackgroundColor(const QColor& color)
+{
+	m_backgroundColor = color;
+	apply_background_brush();
+}
+
+// the class brush paints the window before Qt does, ie: while it is resized
+auto Studio::Softer::Windows::Window::apply_background_brush() -> void
+{
+#ifdef Q_OS_WIN
+	// no brush before the theme is known, it would be released at once by setThemeHash
+	if (m_themeHash.isEmpty()) return;
+
+	auto hwnd = reinterpret_cast<HWND>(winId());
+	auto &resources = paint_resources();
+
+	// the brushes of the previous theme are released once no window class uses them
+	if (resources.theme() != m_themeHash)
+	{
+		::SetClassLongPtrW(hwnd, GCLP_HBRBACKGROUND, 0);
+		resources.setTheme(m_themeHash);
+	}
+
+	::SetClassLongPtrW(hwnd, GCLP_HBRBACKGROUND, reinterpret_cast<LONG_PTR>(resources.brush(m_backgroundColor)));
+#endif
+}
+
+void Studio::Softer::Windows::Window::setIcon(const QString& iconPath)
+{
+	m_appIconPath = iconPath;
+	setWindowIcon(IconCache::instance().icon(iconPath));
+	icon_button_->setIconPath(iconPath);
+}
+
+// the icon is implicitly shared, its pixmaps are decoded once for all the windows
+void Studio::Softer::Windows::Window::setIcon(const QIcon& icon)
+{
+	setWindowIcon(icon);
+	icon_button_->setIconPath(QString());
+	icon_button_->setIcon(icon);
+}
+
+// the mouse events of the borders and the caption, on the platforms without nativeEvent
+auto Studio::Softer::Windows::Window::handle_frame_event(QEvent* event) -> bool
+{
+#ifdef Q_OS_WIN
+	Q_UNUSED(event);
+	return false;
+#else
+	auto type = event->type();
+	if (type != QEvent::MouseMove && type != QEvent::MouseButtonPress &&
+		type != QEvent::MouseButtonRelease && type != QEvent::MouseButtonDblClick)
+		return false;
+
+	auto mouse = static_cast<QMouseEvent *>(event);
+
+	// without system move, the window follows the mouse, moved once per pass of the event loop
+	// with the last position instead of once per mouse event, a double click still maximizes it
+	if (m_manualMove)
+	{
+		if (type == QEvent::MouseMove)
+		{
+			m_moveTarget = mouse->globalPos() - mouse_point_;
+			if (!m_movePending)
+			{
+				m_movePending = true;
+				QTimer::singleShot(0, this, [this]()
+				{
+					m_movePending = false;
+					move(m_moveTarget);
+				});
+			}
+			return true;
+		}
+
+		m_manualMove = false;
+		if (type == QEvent::MouseButtonRelease) return true;
+	}
+
+	if (!m_hitTestMap.isValid()) update_hit_test_map();
+	auto region = m_hitTestMap.hitTest((mouse->localPos() * devicePixelRatioF()).toPoint());
+
+	if (type == QEvent::MouseMove)
+	{
+		if (mouse->buttons() == Qt::NoButton && region != m_cursorRegion)
+		{
+			auto border = region != HitTestMap::Client && region != HitTestMap::Caption;
+			auto wasBorder = m_cursorRegion != HitTestMap::Client && m_cursorRegion != HitTestMap::Caption;
+			if (border) setCursor(to_cursor(region));
+			else if (wasBorder) unsetCursor();
+			m_cursorRegion = region;
+		}
+		return false;
+	}
+
+	if (mouse->button() != Qt::LeftButton || region == HitTestMap::Client)
+		return false;
+
+	if (type == QEvent::MouseButtonDblClick)
+	{
+		if (region != HitTestMap::Caption) return false;
+		if (isMaximized()) slot_restored(); else slot_maximized();
+		return true;
+	}
+
+	if (type != QEvent::MouseButtonPress)
+		return false;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	// the compositor drives the drag, no work is done by the application for each move
+	if (region == HitTestMap::Caption ? windowHandle()->startSystemMove() : windowHandle()->startSystemResize(to_edges(region)))
+		return true;
+#endif
+
+	if (region != HitTestMap::Caption)
+		return false;
+
+	mouse_point_ = mouse->globalPos() - frameGeometry().topLeft();
+	m_manualMove = true;
+	return true;
+#endif
+}
+
+auto Studio::Softer::Windows::Window::update_hit_test_map() -> void
+{
+	QRect caption(title_bar_widget_->mapTo(this, QPoint(0, 0)), title_bar_widget_->size());
+
+	// the children of the title bar keep their mouse events, only the empty space moves the window
+	QVector<QRect> exclusions;
+	for (auto child : title_bar_widget_->findChildren<QWidget *>(QString(), Qt::FindDirectChildrenOnly))
+	{
+		if (child->isVisible())
+			exclusions.append(QRect(child->mapTo(this, QPoint(0, 0)), child->size()));
+	}
+
+	auto resizable = !isMaximized();
+	m_hitTestMap.setResizable(resizable && minimumWidth() != maximumWidth(), resizable && minimumHeight() != maximumHeight());
+	m_hitTestMap.update(size(), caption, exclusions, devicePixelRatioF());
+}
+
+// a monitor with another ratio is applied to the values in device pixels only, the layout is kept
+// and the caption buttons paint the pixmaps they cached for the new ratio
+auto Studio::Softer::Windows::Window::update_metrics() -> void
+{
+	if (!m_metrics.setDevicePixelRatio(devicePixelRatioF()))
+		return;
+
+	m_hitTestMap.setBorderWidth(m_metrics.borderWidth());
+	m_hitTestMap.invalidate();
+	if (title_bar_widget_) title_bar_widget_->update();
+}
+
+auto Studio::Softer::Windows::Window::restore_content_state() -> void
+{
+	auto content = qobject_cast<QMainWindow *>(m_contentHost->content());
+	if (content && !m_contentState.isEmpty())
+		content->restoreState(m_contentState);
+}
+
+Studio::Softer::Windows::ContentHost* Studio::Softer::Windows::Window::contentHost() const
+{
+	return m_contentHost;
+}
+
+bool Studio::Softer::Windows::Window::isContentReady() const
+{
+	return m_contentHost->content() != Q_NULLPTR;
+}
+
+// milliseconds from the construction of the window to the first paint of the shell, -1 before
+qint64 Studio::Softer::Windows::Window::shellVisibleTime() const
+{
+	return m_shellVisibleTime;
+}
+
+// milliseconds from the construction of the window to the creation of the content, -1 before
+qint64 Studio::Softer::Windows::Window::contentReadyTime() const
+{
+	return m_contentReadyTime;
+}
+
+// number of layout requests handled by the window and its content, a warm start needs a single one
+int Studio::Softer::Windows::Window::layoutPassCount() const
+{
+	return m_layoutPasses;
+}
+
+Studio::Softer::Windows::ScreenGeometryCache& Studio::Softer::Windows::Window::screenGeometryCache()
+{
+	return m_screenCache;
+}
+
+// the sizes of the frame, scaled for the screen of the window
+const Studio::Softer::Windows::WindowMetrics& Studio::Softer::Windows::Window::metrics() const
+{
+	return m_metrics;
+}
+
+// the regions of the frame, in device pixels, with the border width of the metrics
+const Studio::Softer::Windows::HitTestMap& Studio::Softer::Windows::Window::hitTestMap() const
+{
+	return m_hitTestMap;
+}
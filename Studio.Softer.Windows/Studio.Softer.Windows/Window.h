@@ -1,57 +1,115 @@
-#ifndef __WINDOW__H_
-#define __WINDOW__H_
-
-#include "studiosofterwindows_global.h"
-
-#include <QtWidgets>
-#include <Windows.h>
-
-namespace Studio
-{
-	namespace Softer
-	{
-		namespace Windows
-		{
-			class STUDIOSOFTERWINDOWS_EXPORT Window : public QMainWindow
-			{
-				Q_OBJECT
-			public:
-				explicit Window(QMenuBar *menuBar);
-				void setIcon(const QString &iconPath);
-				void setapplicationName(const QString &appName);
-				void setOrganizationName(const QString &orgName);
-				void showWindow();
-
-			protected:
-				bool nativeEvent(const QByteArray &eventType, void *message, long *result) override;
-				void mousePressEvent(QMouseEvent *event) override;
-				void closeEvent(QCloseEvent *event) override;
-				void changeEvent(QEvent* e) override;
-
-			private slots:
-				void slot_show_system_menu() const;
-				void slot_minimized();
-				void slot_maximized();
-				void slot_restored();
-				void slot_closed();
-
-			private:
-				auto set_borderless(bool enabled) const -> void;
-				QPushButton *minimize_button_;
-				QPushButton *maximize_button_;
-				QPushButton *restore_button_;
-				QPushButton *close_Button_;
-				QWidget *title_bar_widget_;
-				QPushButton *icon_button_;
-				QWidget *m_centralWidget;
-				QString m_appIconPath;
-				QPoint mouse_point_;
-				QString m_appName;
-				QString m_orgName;
-			};
-		}
-	}
-}
-
-
+#ifndef __WINDOW__H_
+#define __WINDOW__H_
+
+#include "studiosofterwindows_global.h"
+#include "CaptionButton.h"
+#include "ContentHost.h"
+#include "HitTestMap.h"
+#include "ScreenGeometryCache.h"
+#include "SystemMenuModel.h"
+#include "WindowMetrics.h"
+#include "WindowStateAnimator.h"
+
+#include <QtWidgets>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			class STUDIOSOFTERWINDOWS_EXPORT Window : public QMainWindow
+			{
+				Q_OBJECT
+			public:
+				explicit Window(QMenuBar *menuBar, QWidget *content = Q_NULLPTR);
+				Window(QMenuBar *menuBar, const ContentHost::ContentFactory &factory);
+				void setIcon(const QString &iconPath);
+				void setIcon(const QIcon &icon);
+				void setapplicationName(const QString &appName);
+				void setOrganizationName(const QString &orgName);
+				void setThemeHash(const QByteArray &themeHash);
+				void setBackgroundColor(const QColor &color);
+				void setStateAnimationEnabled(bool enabled);
+				const WindowStateAnimator &stateAnimator() const;
+				void showWindow();
+				ContentHost *contentHost() const;
+				bool isContentReady() const;
+				qint64 shellVisibleTime() const;
+				qint64 contentReadyTime() const;
+				int layoutPassCount() const;
+				ScreenGeometryCache &screenGeometryCache();
+				const WindowMetrics &metrics() const;
+				const HitTestMap &hitTestMap() const;
+
+			signals:
+				void shellVisible();
+				void contentReady();
+
+			protected:
+				bool event(QEvent *event) override;
+				bool eventFilter(QObject *watched, QEvent *event) override;
+				bool nativeEvent(const QByteArray &eventType, void *message, long *result) override;
+				void mousePressEvent(QMouseEvent *event) override;
+				void closeEvent(QCloseEvent *event) override;
+				void changeEvent(QEvent* e) override;
+
+			private slots:
+				void slot_show_system_menu();
+				void slot_minimized();
+				void slot_maximized();
+				void slot_restored();
+				void slot_closed();
+
+			private:
+				auto set_borderless(bool enabled) const -> void;
+				auto create_shell(QMenuBar *menuBar) -> void;
+				auto restore_content_state() -> void;
+				auto update_hit_test_map() -> void;
+				auto update_metrics() -> void;
+				auto apply_background_brush() -> void;
+				auto handle_frame_event(QEvent *event) -> bool;
+				auto change_window_state(Qt::WindowState state, const std::function<void()> &apply) -> void;
+				auto show_system_menu(const QPoint &position) -> void;
+				auto run_system_command(SystemMenuModel::Command command) -> void;
+				CaptionButton *minimize_button_;
+				CaptionButton *maximize_button_;
+				CaptionButton *restore_button_;
+				CaptionButton *close_Button_;
+				QWidget *title_bar_widget_;
+				CaptionButton *icon_button_;
+				QWidget *m_centralWidget;
+				HitTestMap m_hitTestMap;
+				ScreenGeometryCache m_screenCache;
+				WindowMetrics m_metrics;
+				WindowStateAnimator m_stateAnimator;
+				SystemMenuModel m_systemMenu;
+				quint64 m_systemMenuRevision;
+				QMenu *m_systemMenuPopup;
+				ContentHost *m_contentHost;
+				QElapsedTimer m_clock;
+				qint64 m_shellVisibleTime;
+				qint64 m_contentReadyTime;
+				int m_layoutPasses;
+				QByteArray m_themeHash;
+				QColor m_backgroundColor;
+				QColor m_titleBarColor;
+				QColor m_titleBarBorderColor;
+				int m_titleBarBorderWidth;
+				bool m_frameMaximized;
+				bool m_manualMove;
+				bool m_movePending;
+				HitTestMap::Region m_cursorRegion;
+				QByteArray m_contentState;
+				QString m_appIconPath;
+				QPoint mouse_point_;
+				QPoint m_moveTarget;
+				QString m_appName;
+				QString m_orgName;
+			};
+		}
+	}
+}
+
+
 #endif
\ No newline at end of file
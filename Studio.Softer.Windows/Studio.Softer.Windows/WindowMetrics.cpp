@@ -0,0 +1,124 @@
+#include "WindowMetrics.h"
+
+#include <QtMath>
+
+namespace {
+	// the sizes of the frame, in device independent pixels
+	const int TitleBarHeight = 30;
+	const QSize CaptionButtonSize(36, 29);
+	const QSize CaptionIconSize(24, 18);
+	const QSize WindowIconSize(20, 20);
+	const int WindowIconMargin = 5;
+	const int BorderWidth = 8;
+	const int MenuOffset = 30;
+}
+
+
+Studio::Softer::Windows::WindowMetrics::WindowMetrics() :
+	m_devicePixelRatio(1.0), m_borderWidth(BorderWidth), m_menuOffset(MenuOffset)
+{
+}
+
+
+/**
+* \brief Allows to scale the metrics for the screen of the window.
+* \param devicePixelRatio The ratio of the screen.
+* \return True when the ratio changed, the values in device pixels have then to be applied again.
+*/
+bool Studio::Softer::Windows::WindowMetrics::setDevicePixelRatio(qreal devicePixelRatio)
+{
+	if (devicePixelRatio <= 0 || qFuzzyCompare(devicePixelRatio, m_devicePixelRatio))
+		return false;
+
+	m_devicePixelRatio = devicePixelRatio;
+	m_borderWidth = toDevicePixels(BorderWidth);
+	m_menuOffset = toDevicePixels(MenuOffset);
+	return true;
+}
+
+
+qreal Studio::Softer::Windows::WindowMetrics::devicePixelRatio() const
+{
+	return m_devicePixelRatio;
+}
+
+
+/**
+* \brief Allows to get the height of the title bar.
+* \return The height, in device independent pixels.
+*/
+int Studio::Softer::Windows::WindowMetrics::titleBarHeight() const
+{
+	return TitleBarHeight;
+}
+
+
+/**
+* \brief Allows to get the size of the minimize, maximize, restore and close buttons.
+* \return The size, in device independent pixels.
+*/
+QSize Studio::Softer::Windows::WindowMetrics::captionButtonSize() const
+{
+	return CaptionButtonSize;
+}
+
+
+/**
+* \brief Allows to get the size of the icons of the caption buttons.
+* \return The size, in device independent pixels, the icons are rasterized at the ratio of the screen.
+*/
+QSize Studio::Softer::Windows::WindowMetrics::captionIconSize() const
+{
+	return CaptionIconSize;
+}
+
+
+/**
+* \brief Allows to get the size of the application icon of the title bar.
+* \return The size, in device independent pixels.
+*/
+QSize Studio::Softer::Windows::WindowMetrics::windowIconSize() const
+{
+	return WindowIconSize;
+}
+
+
+/**
+* \brief Allows to get the space on the left of the application icon.
+* \return The margin, in device independent pixels.
+*/
+int Studio::Softer::Windows::WindowMetrics::windowIconMargin() const
+{
+	return WindowIconMargin;
+}
+
+
+/**
+* \brief Allows to get the width of the resize borders, see HitTestMap.
+* \return The width, in device pixels.
+*/
+int Studio::Softer::Windows::WindowMetrics::borderWidth() const
+{
+	return m_borderWidth;
+}
+
+
+/**
+* \brief Allows to get the distance between the top of the window and its system menu.
+* \return The offset, in device pixels.
+*/
+int Studio::Softer::Windows::WindowMetrics::menuOffset() const
+{
+	return m_menuOffset;
+}
+
+
+/**
+* \brief Allows to scale a size for the screen.
+* \param value The size, in device independent pixels.
+* \return The size, in device pixels.
+*/
+int Studio::Softer::Windows::WindowMetrics::toDevicePixels(int value) const
+{
+	return qRound(value * m_devicePixelRatio);
+}
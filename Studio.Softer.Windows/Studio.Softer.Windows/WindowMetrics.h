@@ -0,0 +1,44 @@
+#ifndef __WINDOWMETRICS__H_
+#define __WINDOWMETRICS__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QSize>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief The sizes of the frame of a window, scaled for the device pixel ratio of its screen.
+			* The widgets are laid out by Qt in device independent pixels and do not change with
+			* the ratio, so that a move to another monitor only scales the values given to the
+			* platform in device pixels, ie: the resize borders, without a new layout.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT WindowMetrics
+			{
+			public:
+				WindowMetrics();
+				bool setDevicePixelRatio(qreal devicePixelRatio);
+				qreal devicePixelRatio() const;
+				int titleBarHeight() const;
+				QSize captionButtonSize() const;
+				QSize captionIconSize() const;
+				QSize windowIconSize() const;
+				int windowIconMargin() const;
+				int borderWidth() const;
+				int menuOffset() const;
+				int toDevicePixels(int value) const;
+
+			private:
+				qreal m_devicePixelRatio;
+				int m_borderWidth;
+				int m_menuOffset;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "WindowStateAnimator.h"
+
+#include <QVariantAnimation>
+#include <QPainter>
+#include <QWidget>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <dwmapi.h>
+#pragma comment(lib, "dwmapi.lib")
+#endif
+
+namespace {
+	// paints the picture of the window, scaled to its own geometry
+	class Overlay : public QWidget
+	{
+	public:
+		explicit Overlay(const QPixmap &frame) :
+			QWidget(Q_NULLPTR, Qt::Tool | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint), m_frame(frame)
+		{
+			setAttribute(Qt::WA_TranslucentBackground);
+			setAttribute(Qt::WA_TransparentForMouseEvents);
+			setAttribute(Qt::WA_ShowWithoutActivating);
+			setAttribute(Qt::WA_DeleteOnClose);
+		}
+
+	protected:
+		void paintEvent(QPaintEvent *) override
+		{
+			QPainter painter(this);
+			painter.setRenderHint(QPainter::SmoothPixmapTransform);
+			painter.drawPixmap(rect(), m_frame);
+		}
+
+	private:
+		QPixmap m_frame;
+	};
+
+	// the interval of the unified timer that drives the Qt animations, it does not follow the refresh rate
+	const qreal animationTimerInterval = 16.0;
+
+	// takes the window off the screen while it keeps its task bar button, its focus and its layout
+	auto conceal(QWidget *window, bool concealed) -> void {
+#ifdef Q_OS_WIN
+		// DWMWA_CLOAK, Windows 8: DWM stops composing the window and its widgets,
+		// it is not made layered as by setWindowOpacity, which would keep WS_EX_LAYERED afterwards
+		BOOL cloak = concealed ? TRUE : FALSE;
+		if (::DwmSetWindowAttribute(reinterpret_cast<HWND>(window->winId()), DWMWINDOWATTRIBUTE(13), &cloak, sizeof(cloak)) == S_OK)
+			return;
+#endif
+		// no cloaking: hiding the window would drop its task bar button and its focus, and lay it out
+		// again when shown, so the compositor is only asked not to draw it
+		window->setWindowOpacity(concealed ? 0.0 : 1.0);
+	}
+}
+
+
+Studio::Softer::Windows::WindowStateAnimator::WindowStateAnimator() :
+	m_animation(Q_NULLPTR), m_duration(180),
+	m_frames(0), m_droppedFrames(0), m_enabled(false)
+{
+}
+
+
+Studio::Softer::Windows::WindowStateAnimator::~WindowStateAnimator()
+{
+	delete m_animation;
+	delete m_overlay;
+}
+
+
+/**
+* \brief Allows to enable the animations, they are disabled by default.
+* \param enabled True to animate the state changes.
+*/
+void Studio::Softer::Windows::WindowStateAnimator::setEnabled(bool enabled)
+{
+	m_enabled = enabled;
+}
+
+
+bool Studio::Softer::Windows::WindowStateAnimator::isEnabled() const
+{
+	return m_enabled;
+}
+
+
+/**
+* \brief Allows to set the duration of a transition.
+* \param duration The duration, in milliseconds.
+*/
+void Studio::Softer::Windows::WindowStateAnimator::setDuration(int duration)
+{
+	m_duration = duration;
+}
+
+
+bool Studio::Softer::Windows::WindowStateAnimator::isRunning() const
+{
+	return m_animation != Q_NULLPTR;
+}
+
+
+/**
+* \brief Allows to animate a window from a geometry to another, then to apply its new state.
+* \param window The top-level window.
+* \param from The geometry at the start of the transition, in global coordinates.
+* \param to The geometry at the end of the transition, in global coordinates.
+* \param apply The function that changes the state of the window, ie: setWindowState.
+*/
+void Studio::Softer::Windows::WindowStateAnimator::animate(QWidget* window, const QRect& from, const QRect& to, const std::function<void()>& apply)
+{
+	// a transition in progress ends at once, in its final state
+	if (m_animation) finish();
+
+	m_window = window;
+	m_apply = apply;
+	m_frames = 0;
+	m_droppedFrames = 0;
+
+	// the only picture of the window for the whole transition
+	auto overlay = new Overlay(window->grab());
+	overlay->setGeometry(from);
+	overlay->show();
+	m_overlay = overlay;
+
+	// the window is kept, and not hidden, so that it keeps its task bar button and its focus
+	conceal(window, true);
+
+	m_animation = new QVariantAnimation;
+	m_animation->setDuration(m_duration);
+	m_animation->setEasingCurve(QEasingCurve::OutCubic);
+	m_animation->setStartValue(from);
+	m_animation->setEndValue(to);
+	QObject::connect(m_animation, &QVariantAnimation::valueChanged, overlay, [this, overlay](const QVariant &value)
+	{
+		next_frame(overlay, value.toRect());
+	});
+	QObject::connect(m_animation, &QVariantAnimation::finished, [this]() { finish(); });
+
+	m_frameClock.start();
+	m_animation->start();
+}
+
+
+/**
+* \brief Allows to get the number of frames of the last transition.
+* \return The number of frames painted.
+*/
+int Studio::Softer::Windows::WindowStateAnimator::frames() const
+{
+	return m_frames;
+}
+
+
+/**
+* \brief Allows to get the number of frames missed by the last transition.
+* \return The number of ticks of the animation timer without a new frame.
+*/
+int Studio::Softer::Windows::WindowStateAnimator::droppedFrames() const
+{
+	return m_droppedFrames;
+}
+
+
+void Studio::Softer::Windows::WindowStateAnimator::next_frame(QWidget* overlay, const QRect& geometry)
+{
+	// the animation timer ticks every 16 ms, a longer interval is a missed tick
+	auto elapsed = m_frameClock.nsecsElapsed() / 1000000.0;
+	m_frameClock.restart();
+	if (m_frames > 0)
+		m_droppedFrames += qMax(0, qRound(elapsed / animationTimerInterval) - 1);
+	++m_frames;
+
+	overlay->setGeometry(geometry);
+}
+
+
+void Studio::Softer::Windows::WindowStateAnimator::finish()
+{
+	auto animation = m_animation;
+	m_animation = Q_NULLPTR;
+	if (animation)
+	{
+		animation->stop();
+		animation->deleteLater();
+	}
+
+	// the new state is laid out once, then the window replaces its picture
+	if (m_window)
+	{
+		if (m_apply) m_apply();
+		conceal(m_window, false);
+	}
+	m_apply = std::function<void()>();
+
+	if (m_overlay) m_overlay->close();
+}
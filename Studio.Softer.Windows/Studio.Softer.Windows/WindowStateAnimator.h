@@ -0,0 +1,66 @@
+#ifndef __WINDOWSTATEANIMATOR__H_
+#define __WINDOWSTATEANIMATOR__H_
+
+#include "studiosofterwindows_global.h"
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QRect>
+
+#include <functional>
+
+class QVariantAnimation;
+class QWidget;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			/**
+			* \brief Animates the minimize, maximize and restore transitions of a window.
+			* The window is grabbed once into a pixmap that is moved and scaled by a top-level
+			* overlay. The window is cloaked meanwhile, or transparent where the platform cannot
+			* cloak it, its new state is applied at the end, so that it is laid out only once.
+			*
+			* The frames follow the unified timer of the Qt animations, every 16 ms, and not the
+			* vertical sync of the screen: a widget has no presentation callback in Qt 5. A frame
+			* may thus be shown twice at 60 Hz and a faster screen gets no more frames,
+			* droppedFrames counts the ticks that came late.
+			*/
+			class STUDIOSOFTERWINDOWS_EXPORT WindowStateAnimator
+			{
+			public:
+				WindowStateAnimator();
+				~WindowStateAnimator();
+				void setEnabled(bool enabled);
+				bool isEnabled() const;
+				void setDuration(int duration);
+				bool isRunning() const;
+				void animate(QWidget *window, const QRect &from, const QRect &to, const std::function<void()> &apply);
+				int frames() const;
+				int droppedFrames() const;
+
+			private:
+				WindowStateAnimator(const WindowStateAnimator &) = delete;
+				WindowStateAnimator &operator=(const WindowStateAnimator &) = delete;
+
+				void next_frame(QWidget *overlay, const QRect &geometry);
+				void finish();
+
+				QPointer<QWidget> m_window;
+				QPointer<QWidget> m_overlay;
+				QVariantAnimation *m_animation;
+				std::function<void()> m_apply;
+				QElapsedTimer m_frameClock;
+				int m_duration;
+				int m_frames;
+				int m_droppedFrames;
+				bool m_enabled;
+			};
+		}
+	}
+}
+
+#endif
\ No newline at end of file
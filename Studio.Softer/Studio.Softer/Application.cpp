@@ -1,221 +1,548 @@
-#include "Application.h"
-#include "Window.h"
-
-#include <QFile>
-
-/**
-* \brief Allows to initialize a new application.
-* \param argc The integer(argc) of the main function.
-* \param argv The *char[] pointer of the main function.
-*/
-Studio::Softer::Application::Application(int argc, char *argv[]) :
-	m_splashScreen(Q_NULLPTR), m_sharedMemory(Q_NULLPTR), m_application(Q_NULLPTR),
-	m_menuBar(Q_NULLPTR)
-{
-	//Initialize a new application.
-	m_application = new QApplication(argc, argv);
-
-	//Initialize a new shared memory.
-	m_sharedMemory = new QSharedMemory("{cca65ba4-6e42-4997-99a3-7e143aaf83b5}");
-
-	//Enables high-DPI scaling on windows.
-	m_application->setAttribute(Qt::AA_EnableHighDpiScaling);
-	//Allows to use pixmap sizes in layout geometry.
-	//Calculations should typically divide by devicePixelRatio().
-	m_application->setAttribute(Qt::AA_UseHighDpiPixmaps);
-
-	//Indicates the application infos.
-	m_application->setApplicationName(getApplicationName());
-	m_application->setApplicationVersion(getApplicationVersion());
-	m_application->setOrganizationName(getOrganizationName());
-	m_application->setOrganizationDomain(getOrganizationDomain());
-
-	//Allows to use a stylesheet file to skinning this application.
-	QFile File(":/themes/DarkStyle.qss");
-	File.open(QFile::ReadOnly);
-	m_application->setStyleSheet(File.readAll());
-}
-
-
-/**
-* \brief Allows to set the product type for an application.
-* \param product The product type of an application.
-*/
-void Studio::Softer::Application::setProductType(const ProductType& product)
-{
-	m_product = product;
-}
-
-
-/**
-* \brief Allows to execute the application.
-* \return The good integer when the application is running or not.
-*/
-int Studio::Softer::Application::exec()
-{
-	//Verifies if the application is already launched.
-	if (m_sharedMemory->create(sizeof(int)) == false)
-	{
-		exit(1);
-	}
-
-	//New instance of QSplashScreen;
-	m_splashScreen = new QSplashScreen();
-
-	//Shows the splash screen and version of an application, if getSplashScreenPath() is not empty.
-	if (!getSplashScreenPath().isEmpty())
-	{
-		QPixmap pixmap(getSplashScreenPath());
-		m_splashScreen->setPixmap(pixmap);
-		m_splashScreen->showMessage("Version: " + getApplicationVersion(),
-			Qt::AlignBottom | Qt::AlignRight, QColor(255, 255, 255));
-		m_splashScreen->show();
-	}
-
-	//Thread for an process.
-	m_application->processEvents();
-
-	//Creates and Shows the main window.
-	Windows::Window window(m_menuBar);
-	window.setOrganizationName(getOrganizationName());
-	window.setapplicationName(getApplicationName());
-	window.setWindowTitle(getApplicationName());
-	if (!getApplicationIconPath().isEmpty())
-		window.setIcon(getApplicationIconPath());
-	else
-		window.setIcon(":/Icons/icon.png");
-	window.showWindow();
-	if (!getSplashScreenPath().isEmpty()) m_splashScreen->finish(&window);
-	
-	return m_application->exec();
-}
-
-
-/**
-* \brief Allows to get the path of application icon.
-* \return The path of application icon.
-*/
-QString Studio::Softer::Application::getApplicationIconPath() const
-{
-	return m_appIconPath;
-}
-
-
-/**
-* \brief Allows to get the application version.
-* \return The application version.
-*/
-QString Studio::Softer::Application::getApplicationVersion() const
-{
-	return m_appVersion;
-}
-
-
-/**
-* \brief Allows to get the organization domain.
-* \return The organization domain.
-*/
-QString Studio::Softer::Application::getOrganizationDomain() const
-{
-	return m_orgDomain;
-}
-
-
-/**
-* \brief Allows to get the application name.
-* \return The application name.
-*/
-QString Studio::Softer::Application::getApplicationName() const
-{
-	return m_appName;
-}
-
-
-/**
-* \brief Allows to get the organization name.
-* \return The organization name.
-*/
-QString Studio::Softer::Application::getOrganizationName() const
-{
-	return m_orgName;
-}
-
-
-/**
-* \brief Allows to get the path of splashscreen.
-* \return The path of splashscreen.
-*/
-QString Studio::Softer::Application::getSplashScreenPath() const
-{
-	return m_splashPath;
-}
-
-
-/**
-* \brief Allows to get the product type of an application.
-* \return The product type.
-*/
-ProductType Studio::Softer::Application::getProductType() const
-{
-	return m_product;
-}
-
-
-/**
-* \brief Allows to set the application name.
-* \param appName The name of this application.
-*/
-void Studio::Softer::Application::setApplicationName(const QString& appName)
-{
-	m_appName = appName;
-}
-
-
-/**
-* \brief Allows to set the application version.
-* \param appVersion The version of this application.
-*/
-void Studio::Softer::Application::setApplicationVersion(const QString& appVersion)
-{
-	m_appVersion = appVersion;
-}
-
-
-/**
-* \brief Allows to set the organization name.
-* \param orgName The organization name of this application.
-*/
-void Studio::Softer::Application::setOrganizationName(const QString& orgName)
-{
-	m_orgName = orgName;
-}
-
-
-/**
-* \brief Allows to set the organization domain of an application.
-* \param orgDomain The organization doamin of an application.
-*/
-void Studio::Softer::Application::setOrganizationDomain(const QString& orgDomain)
-{
-	m_orgDomain = orgDomain;
-}
-
-
-/**
-* \brief Allows to set the splash screen path.
-* \param splashPath The splash screen path.
-*/
-void Studio::Softer::Application::setSplashScreenPath(const QString& splashPath)
-{
-	m_splashPath = splashPath;
-}
-
-
-/**
-* \brief Allows to set the icon path for an application.
-* \param iconPath The icon path.
-*/
-void Studio::Softer::Application::setApplicationIconPath(const QString& iconPath)
-{
-	m_appIconPath = iconPath;
-}
+#include "Application.h"
+#include "IconCache.h"
+#include "NativePaintResources.h"
+#include "ProductRegistry.h"
+#include "ResourceBundles.h"
+#include "SettingsStore.h"
+#include "SingleInstance.h"
+#include "StartupTracer.h"
+#include "StyleSheetReloader.h"
+#include "Style_qss.h"
+#include "ThemeEngine.h"
+#include "Window.h"
+#include "WindowManager.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFileInfo>
+#include <QDir>
+#include <QWindow>
+#include <QActionGroup>
+#include <QMenu>
+#include <QTimer>
+
+namespace {
+	//The number of windows opened by the benchmark mode, --benchmark-windows=<count>.
+	auto benchmark_window_count(const QStringList& arguments) -> int {
+		const QString option("--benchmark-windows=");
+		for (const auto &argument : arguments)
+		{
+			if (argument.startsWith(option))
+				return qMax(1, argument.mid(option.size()).toInt());
+		}
+		return qMax(1, qEnvironmentVariableIntValue("STUDIO_SOFTER_BENCHMARK_WINDOWS"));
+	}
+
+	//The value of an option, ie: --theme=<name or file>, or else of its environment variable.
+	auto option_value(const QStringList& arguments, const QString& option, const char *variable) -> QString {
+		for (const auto &argument : arguments)
+		{
+			if (argument.startsWith(option))
+				return argument.mid(option.size());
+		}
+		return QString::fromLocal8Bit(qgetenv(variable));
+	}
+
+	//The transitions of the window states are animated with --animate-window-states, or by the persisted setting.
+	auto state_animation_enabled(const QStringList& arguments) -> bool {
+		if (arguments.contains("--animate-window-states"))
+			return true;
+		return Studio::Softer::Windows::SettingsStore::instance().value("Window/AnimateStates", false).toBool();
+	}
+
+	//The built-in stylesheet is compiled into tables at build time, only the other ones are parsed.
+	//The variables are the tokens of the current theme.
+	auto load_style_sheet(const QString& path, const QHash<QString, QString>& variables) -> Studio::Softer::Windows::StyleSheet {
+		using Studio::Softer::Windows::StyleSheet;
+		if (path == ":/themes/Style.qss") return StyleSheet::fromTable(Studio::Softer::Styles::Style::table, variables);
+		return StyleSheet::load(path, variables);
+	}
+
+	//Records the first frame of a window, ie: the shell with the title bar or the splash screen.
+	class FirstFrameObserver : public QObject
+	{
+	public:
+		FirstFrameObserver(QObject *parent, const char *mark) : QObject(parent), m_mark(mark) {}
+
+	protected:
+		bool eventFilter(QObject *watched, QEvent *event) override
+		{
+			if (event->type() == QEvent::Expose && static_cast<QWindow *>(watched)->isExposed())
+			{
+				watched->removeEventFilter(this);
+
+				//The frame is painted and flushed while the expose event is delivered.
+				auto mark = m_mark;
+				QTimer::singleShot(0, [mark]() { Studio::Softer::StartupTracer::instance().mark(mark); });
+			}
+			return false;
+		}
+
+	private:
+		const char *m_mark;
+	};
+}
+
+/**
+* \brief Allows to initialize a new application.
+* \param argc The integer(argc) of the main function.
+* \param argv The *char[] pointer of the main function.
+*/
+Studio::Softer::Application::Application(int argc, char *argv[]) :
+	m_splashWatcher(Q_NULLPTR), m_splashScreen(Q_NULLPTR), m_singleInstance(Q_NULLPTR), m_application(Q_NULLPTR),
+	m_product(None), m_windowManager(Q_NULLPTR), m_styleSheetReloader(Q_NULLPTR), m_isSecondary(false)
+{
+	//Starts the startup clock before anything else.
+	auto &tracer = StartupTracer::instance();
+	tracer.configure(argc, argv);
+	StartupPhase applicationPhase("Application");
+
+	for (auto i = 0; i < argc; ++i)
+		m_arguments.append(QString::fromLocal8Bit(argv[i]));
+
+	//Verifies if the application is already launched, before paying for QApplication.
+	//The running instance is then brought to the front, the products do not open files from the command line.
+	//One instance per executable, ie: a benchmark does not activate the installed application.
+	tracer.begin("SingleInstance.Forward");
+	auto executable = argc > 0 ? QFileInfo(QString::fromLocal8Bit(argv[0])).completeBaseName() : QString();
+	m_singleInstance = new SingleInstance("{cca65ba4-6e42-4997-99a3-7e143aaf83b5}-" + executable);
+	m_isSecondary = m_singleInstance->forwardToPrimary(m_arguments);
+	tracer.end("SingleInstance.Forward");
+	if (m_isSecondary) return;
+
+	//Enables high-DPI scaling on windows, read by the constructor of QApplication only.
+	QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
+	//Allows to use pixmap sizes in layout geometry.
+	//Calculations should typically divide by devicePixelRatio().
+	QCoreApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
+
+	//Initialize a new application.
+	tracer.begin("QApplication");
+	m_application = new QApplication(argc, argv);
+	tracer.end("QApplication");
+
+	//Indicates the application infos.
+	m_application->setApplicationName(getApplicationName());
+	m_application->setApplicationVersion(getApplicationVersion());
+	m_application->setOrganizationName(getOrganizationName());
+	m_application->setOrganizationDomain(getOrganizationDomain());
+
+	//Selects the theme before the first widget, the dark one by default.
+	StartupPhase phase("Stylesheet");
+	auto &themes = Windows::ThemeEngine::instance();
+	themes.setStyleTable(&Styles::Style::table);
+	auto theme = option_value(m_arguments, "--theme=", "STUDIO_SOFTER_THEME");
+	if (QFileInfo(theme).isFile()) theme = themes.loadTheme(theme);
+	if (!theme.isEmpty() && !themes.setTheme(theme))
+		qWarning("Unknown theme %s, the %s theme is used", qPrintable(theme), qPrintable(themes.themeName()));
+
+	//Allows to use a stylesheet file to skinning this application.
+	//The built-in ones come from the tables of Studio.Softer.QssCompiler, the others are parsed once
+	//and cached on the disk, keyed by the hash of their content.
+	//The native rules, ie: of the palette and the title bar, are always read from the typed tables.
+	//For the development of a theme, --theme-file=<qss> is read from the disk and reloaded when saved,
+	//it is kept by a switch of theme and resolved with the tokens of the new one.
+	//The palette and the stylesheet are applied now and again by each switch of theme.
+	//The first stylesheet is set on the application, a switch or a save of the file only applies
+	//the rules that changed to the widgets they match, the other widgets are not polished again.
+	auto themeFile = option_value(m_arguments, "--theme-file=", "STUDIO_SOFTER_THEME_FILE");
+	themes.bindApplication(m_application, [this, themeFile](const Windows::Theme &theme)
+	{
+		m_styleSheet = load_style_sheet(themeFile.isEmpty() ? theme.styleSheetPath : themeFile, Windows::ThemeEngine::instance().styleSheetVariables());
+		if (m_windowManager) m_windowManager->setThemeHash(m_styleSheet.hash());
+
+		if (m_styleSheetReloader)
+		{
+			m_styleSheetReloader->apply(m_styleSheet);
+			return;
+		}
+		m_application->setStyleSheet(m_styleSheet.text());
+		m_styleSheetReloader = new Windows::StyleSheetReloader(m_styleSheet);
+	});
+	if (m_styleSheet.isFromCache()) tracer.mark("StylesheetCacheHit");
+	if (!themeFile.isEmpty() && !m_styleSheetReloader->watch(themeFile))
+		qWarning("Cannot watch the stylesheet %s", qPrintable(themeFile));
+}
+
+
+/**
+* \brief Allows to release the windows, the single instance server and the QApplication.
+* The server is closed here, so that the next launch does not find a stale socket.
+*/
+Studio::Softer::Application::~Application()
+{
+	delete m_windowManager;
+	delete m_styleSheetReloader;
+	delete m_splashScreen;
+	delete m_singleInstance;
+	delete m_application;
+}
+
+
+/**
+* \brief Allows to set the product type for an application.
+* Only the module of this product is loaded, see ProductRegistry.
+* \param product The product type of an application.
+*/
+void Studio::Softer::Application::setProductType(const ProductType& product)
+{
+	m_product = product;
+}
+
+
+/**
+* \brief Allows to execute the application.
+* \return The good integer when the application is running or not.
+*/
+int Studio::Softer::Application::exec()
+{
+	auto &tracer = StartupTracer::instance();
+
+	//The running instance was activated instead.
+	if (m_isSecondary) return 0;
+
+	//Becomes the running instance, unless another one started in the meantime.
+	tracer.begin("SingleInstance.Listen");
+	auto listening = m_singleInstance->listen();
+	tracer.end("SingleInstance.Listen");
+	if (!listening)
+		return m_singleInstance->forwardToPrimary(m_arguments) ? 0 : 1;
+
+	//Reads the persisted window state in the background while the splash screen is shown.
+	auto &settings = Windows::SettingsStore::instance();
+	settings.load(getOrganizationName(), getApplicationName());
+
+	//New instance of QSplashScreen, it is shown by the event loop as soon as its image is decoded.
+	//The window is built on this thread meanwhile, the image is not waited for.
+	m_splashScreen = new QSplashScreen();
+	if (!getSplashScreenPath().isEmpty())
+	{
+		m_splashWatcher = new QFutureWatcher<QImage>(m_splashScreen);
+		QObject::connect(m_splashWatcher, &QFutureWatcher<QImage>::finished, [this]() { showSplashScreen(); });
+		m_splashWatcher->setFuture(m_splashImage);
+	}
+	showProgress(QObject::tr("Starting"), 0);
+
+	//Creates and Shows the main window, with the content of the selected product.
+	//The next windows share its theme, icon and menus, see WindowManager.
+	tracer.begin("Window.Construct");
+	m_windowManager = new WindowManager;
+	m_windowManager->setContentFactory(ProductRegistry::instance().contentFactory(getProductType()));
+	m_windowManager->setApplicationInfo(getOrganizationName(), getApplicationName());
+	m_windowManager->setThemeHash(m_styleSheet.hash());
+	m_windowManager->setStateAnimationEnabled(state_animation_enabled(m_arguments));
+	m_windowManager->setIcon(Windows::IconCache::instance().icon(ResourceBundles::instance().resolve(getApplicationIconPath(), ":/Icons/icon.png")));
+
+	auto fileMenu = m_windowManager->addMenu(QObject::tr("&File"));
+	fileMenu->addAction(QObject::tr("New &Window"), [this]() { m_windowManager->openWindow(); }, QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_N));
+	fileMenu->addAction(QObject::tr("&Close Window"), [this]()
+	{
+		if (auto window = m_windowManager->activeWindow()) window->close();
+	}, QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_W));
+
+	//The themes are switched at runtime, see ThemeEngine::bindApplication.
+	auto viewMenu = m_windowManager->addMenu(QObject::tr("&View"));
+	auto themeMenu = viewMenu->addMenu(QObject::tr("&Theme"));
+	auto themeGroup = new QActionGroup(themeMenu);
+	for (const auto &name : Windows::ThemeEngine::instance().themes())
+	{
+		auto action = themeMenu->addAction(name, [name]() { Windows::ThemeEngine::instance().setTheme(name); });
+		action->setCheckable(true);
+		action->setChecked(name == Windows::ThemeEngine::instance().themeName());
+		themeGroup->addAction(action);
+	}
+
+	auto window = m_windowManager->createWindow();
+	tracer.end("Window.Construct");
+
+	//The first frame of the window closes the splash screen, it is not shown at all when its image is decoded later.
+	if (m_splashWatcher)
+	{
+		QObject::connect(window, &Windows::Window::shellVisible, m_splashScreen, [this, window]()
+		{
+			delete m_splashWatcher;
+			m_splashWatcher = Q_NULLPTR;
+			if (m_splashScreen->isVisible()) m_splashScreen->finish(window);
+		});
+	}
+
+	//Brings the active window to the front when the application is launched again.
+	//Its arguments are not used, as the ones of the first launch.
+	m_singleInstance->setMessageHandler([this](const QStringList &arguments, const QString &workingDirectory)
+	{
+		Q_UNUSED(arguments);
+		Q_UNUSED(workingDirectory);
+		auto window = m_windowManager->activeWindow();
+		if (!window) window = m_windowManager->openWindow();
+		if (window->isMinimized()) window->showNormal();
+		window->raise();
+		window->activateWindow();
+	});
+	showProgress(QObject::tr("Restoring the window"), 70);
+
+	if (tracer.isEnabled())
+	{
+		tracer.setMetadata("platform", QGuiApplication::platformName());
+		tracer.setMetadata("persistedState", settings.contains("Window/Snapshot") || settings.contains("Window/Geometry"));
+		window->windowHandle()->installEventFilter(new FirstFrameObserver(window, "FirstFrame"));
+		QTimer::singleShot(0, [&tracer]() { tracer.mark("EventLoop"); });
+
+		//The content is created after the first frame, the startup trace is written there.
+		auto windowCount = tracer.isBenchmark() ? benchmark_window_count(m_arguments) : 1;
+		QObject::connect(window, &Windows::Window::shellVisible, [&tracer]() { tracer.mark("Window.ShellVisible"); });
+		QObject::connect(window, &Windows::Window::contentReady, [this, &tracer, window, windowCount]()
+		{
+			tracer.mark("Window.ContentReady");
+			tracer.setMetadata("shellVisibleMs", window->shellVisibleTime());
+			tracer.setMetadata("contentReadyMs", window->contentReadyTime());
+			tracer.setMetadata("layoutPasses", window->layoutPassCount());
+			tracer.setMetadata("screenCacheHits", window->screenGeometryCache().hits());
+			tracer.setMetadata("screenCacheMisses", window->screenGeometryCache().misses());
+			tracer.setMetadata("nativeHandles", Windows::NativePaintResources::liveHandles());
+			tracer.setMetadata("iconCacheHits", Windows::IconCache::instance().hits());
+			tracer.setMetadata("iconCacheMisses", Windows::IconCache::instance().misses());
+			tracer.setMetadata("iconCacheBytes", Windows::IconCache::instance().bytes());
+			tracer.setMetadata("iconDecodedBytes", Windows::IconCache::instance().decodedBytes());
+			tracer.setMetadata("themeBindings", Windows::ThemeEngine::instance().bindingCount());
+			tracer.setMetadata("windows", windowCount);
+			benchmarkWindows(windowCount - 1);
+		});
+	}
+
+	tracer.begin("Window.Show");
+	m_windowManager->showWindow(window);
+	tracer.end("Window.Show");
+	showProgress(QObject::tr("Ready"), 100);
+
+	auto result = m_application->exec();
+	delete m_windowManager;
+	m_windowManager = Q_NULLPTR;
+	delete m_styleSheetReloader;
+	m_styleSheetReloader = Q_NULLPTR;
+
+	//Waits for the last changes of the settings, they are written in the background.
+	settings.sync();
+	return result;
+}
+
+
+/**
+* \brief Allows to open the next windows of the benchmark, one after the other.
+* Each window is timed from its creation to its content, then the startup trace is written.
+* \param count The number of windows still to open.
+*/
+void Studio::Softer::Application::benchmarkWindows(int count)
+{
+	auto &tracer = StartupTracer::instance();
+	if (count <= 0)
+	{
+		tracer.write();
+		if (tracer.writeBenchmark())
+			QCoreApplication::quit();
+		return;
+	}
+
+	auto phase = QString("Window.Open.%1").arg(m_windowManager->windows().size() + 1);
+	tracer.begin(phase);
+	auto window = m_windowManager->openWindow();
+	QObject::connect(window, &Windows::Window::contentReady, [this, &tracer, phase, count]()
+	{
+		tracer.end(phase);
+		benchmarkWindows(count - 1);
+	});
+}
+
+
+/**
+* \brief Allows to show a startup phase on the splash screen.
+* The phase is kept until the splash screen appears when it is not shown yet.
+* \param phase The name of the startup phase.
+* \param percent The progress of the startup, from 0 to 100.
+*/
+void Studio::Softer::Application::showProgress(const QString& phase, int percent)
+{
+	if (getSplashScreenPath().isEmpty()) return;
+
+	m_progress = QString("%1 %2%   Version: %3").arg(phase).arg(percent).arg(getApplicationVersion());
+	if (m_splashScreen->isVisible())
+		m_splashScreen->showMessage(m_progress, Qt::AlignBottom | Qt::AlignRight, QColor(255, 255, 255));
+
+	//Thread for an process, ie: shows the splash screen once its image is decoded.
+	m_application->processEvents();
+}
+
+
+/**
+* \brief Allows to show the splash screen with the last phase, when its image is decoded.
+* The first pixel is marked when its window is exposed, not when it is asked to show.
+*/
+void Studio::Softer::Application::showSplashScreen()
+{
+	auto image = m_splashImage.result();
+	if (image.isNull()) return;
+
+	StartupPhase startupPhase("SplashScreen");
+	m_splashScreen->setPixmap(QPixmap::fromImage(image));
+	m_splashScreen->createWinId();
+	m_splashScreen->windowHandle()->installEventFilter(new FirstFrameObserver(m_splashScreen, "Splash.FirstPixel"));
+	m_splashScreen->show();
+	m_splashScreen->showMessage(m_progress, Qt::AlignBottom | Qt::AlignRight, QColor(255, 255, 255));
+}
+
+
+/**
+* \brief Allows to get the path of application icon.
+* \return The path of application icon.
+*/
+QString Studio::Softer::Application::getApplicationIconPath() const
+{
+	return m_appIconPath;
+}
+
+
+/**
+* \brief Allows to get the application version.
+* \return The application version.
+*/
+QString Studio::Softer::Application::getApplicationVersion() const
+{
+	return m_appVersion;
+}
+
+
+/**
+* \brief Allows to get the organization domain.
+* \return The organization domain.
+*/
+QString Studio::Softer::Application::getOrganizationDomain() const
+{
+	return m_orgDomain;
+}
+
+
+/**
+* \brief Allows to get the application name.
+* \return The application name.
+*/
+QString Studio::Softer::Application::getApplicationName() const
+{
+	return m_appName;
+}
+
+
+/**
+* \brief Allows to get the organization name.
+* \return The organization name.
+*/
+QString Studio::Softer::Application::getOrganizationName() const
+{
+	return m_orgName;
+}
+
+
+/**
+* \brief Allows to get the path of splashscreen.
+* \return The path of splashscreen.
+*/
+QString Studio::Softer::Application::getSplashScreenPath() const
+{
+	return m_splashPath;
+}
+
+
+/**
+* \brief Allows to get the product type of an application.
+* \return The product type.
+*/
+ProductType Studio::Softer::Application::getProductType() const
+{
+	return m_product;
+}
+
+
+/**
+* \brief Allows to set the application name.
+* \param appName The name of this application.
+*/
+void Studio::Softer::Application::setApplicationName(const QString& appName)
+{
+	m_appName = appName;
+}
+
+
+/**
+* \brief Allows to set the application version.
+* \param appVersion The version of this application.
+*/
+void Studio::Softer::Application::setApplicationVersion(const QString& appVersion)
+{
+	m_appVersion = appVersion;
+}
+
+
+/**
+* \brief Allows to set the organization name.
+* \param orgName The organization name of this application.
+*/
+void Studio::Softer::Application::setOrganizationName(const QString& orgName)
+{
+	m_orgName = orgName;
+}
+
+
+/**
+* \brief Allows to set the organization domain of an application.
+* \param orgDomain The organization doamin of an application.
+*/
+void Studio::Softer::Application::setOrganizationDomain(const QString& orgDomain)
+{
+	m_orgDomain = orgDomain;
+}
+
+
+/**
+* \brief Allows to set the splash screen path.
+* \param splashPath The splash screen path.
+*/
+void Studio::Softer::Application::setSplashScreenPath(const QString& splashPath)
+{
+	if (m_isSecondary) return;
+
+	//No splash screen when its bundle is not deployed.
+	m_splashPath = ResourceBundles::instance().resolve(splashPath);
+
+	//Decodes the splash image on a worker thread while the main window is being built.
+	auto path = m_splashPath;
+	if (!path.isEmpty())
+		m_splashImage = QtConcurrent::run([path]() { return QImage(path); });
+}
+
+
+/**
+* \brief Allows to declare resources shipped in an external .rcc file.
+* The file is loaded the first time one of its resources is used.
+* \param name The name of the bundle, the file is resources/<name>.rcc next to the executable.
+* \param prefixes The resource paths provided by the bundle.
+*/
+void Studio::Softer::Application::addResourceBundle(const QString& name, const QStringList& prefixes)
+{
+	ResourceBundles::instance().addBundle(name, prefixes);
+}
+
+
+/**
+* \brief Allows to set the icon path for an application.
+* \param iconPath The icon path.
+*/
+void Studio::Softer::Application::setApplicationIconPath(const QString& iconPath)
+{
+	m_appIconPath = iconPath;
+	if (m_isSecondary) return;
+
+	//Decodes the icons on a worker thread while the splash screen is shown, ie: the multi-image .ico.
+	//The caption buttons come first, the window asks for them before the application icon.
+	QStringList paths;
+	for (const auto &name : QDir(":/Icons/IconsCommand").entryList(QDir::Files))
+		paths.append(":/Icons/IconsCommand/" + name);
+	paths.append(ResourceBundles::instance().resolve(iconPath, ":/Icons/icon.png"));
+	Windows::IconCache::instance().warmUp(paths);
+}
@@ -1,53 +1,76 @@
-#ifndef __APPLICATION__H_
-#define __APPLICATION__H_
-
-#include "studiosofter_global.h"
-#include "ProductType.h"
-
-#include <QSplashScreen>
-#include <QSharedMemory>
-#include <QApplication>
-#include <QMenuBar>
-
-namespace Studio
-{
-	namespace Softer
-	{
-		class STUDIOSOFTER_EXPORT Application
-		{
-		public:
-			Application(int argc, char *argv[]);
-			void setProductType(const ProductType &product);
-			void setApplicationName(const QString &appName);
-			void setOrganizationName(const QString &orgName);
-			void setSplashScreenPath(const QString &splashPath);
-			void setApplicationIconPath(const QString &iconPath);
-			void setOrganizationDomain(const QString &orgDomain);
-			void setApplicationVersion(const QString &appVersion);
-			int exec();
-
-		private:
-			QString getApplicationIconPath() const;
-			QString getApplicationVersion() const;
-			QString getOrganizationDomain() const;
-			QString getOrganizationName() const;
-			QString getSplashScreenPath() const;
-			QString getApplicationName() const;
-			ProductType getProductType() const;
-
-			QSplashScreen *m_splashScreen;
-			QSharedMemory *m_sharedMemory;
-			QApplication *m_application;
-			ProductType m_product;
-			QString m_appIconPath;
-			QString m_appVersion;
-			QString m_splashPath;
-			QString m_orgDomain;
-			QMenuBar *m_menuBar;
-			QString m_orgName;
-			QString m_appName;
-		};
-	}
-}
-
+#ifndef __APPLICATION__H_
+#define __APPLICATION__H_
+
+#include "studiosofter_global.h"
+#include "ProductType.h"
+#include "StyleSheet.h"
+
+#include <QSplashScreen>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QApplication>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		class SingleInstance;
+		class WindowManager;
+
+		namespace Windows
+		{
+			class StyleSheetReloader;
+		}
+
+		class STUDIOSOFTER_EXPORT Application
+		{
+		public:
+			Application(int argc, char *argv[]);
+			~Application();
+			void setProductType(const ProductType &product);
+			void setApplicationName(const QString &appName);
+			void setOrganizationName(const QString &orgName);
+			void setSplashScreenPath(const QString &splashPath);
+			void setApplicationIconPath(const QString &iconPath);
+			void setOrganizationDomain(const QString &orgDomain);
+			void setApplicationVersion(const QString &appVersion);
+			void addResourceBundle(const QString &name, const QStringList &prefixes);
+			int exec();
+
+		private:
+			Q_DISABLE_COPY(Application)
+			QString getApplicationIconPath() const;
+			QString getApplicationVersion() const;
+			QString getOrganizationDomain() const;
+			QString getOrganizationName() const;
+			QString getSplashScreenPath() const;
+			QString getApplicationName() const;
+			ProductType getProductType() const;
+			void showProgress(const QString &phase, int percent);
+			void showSplashScreen();
+			void benchmarkWindows(int count);
+
+			Windows::StyleSheet m_styleSheet;
+			QFuture<QImage> m_splashImage;
+			QFutureWatcher<QImage> *m_splashWatcher;
+			QSplashScreen *m_splashScreen;
+			SingleInstance *m_singleInstance;
+			QApplication *m_application;
+			ProductType m_product;
+			QString m_appIconPath;
+			QString m_appVersion;
+			QString m_splashPath;
+			QString m_progress;
+			QString m_orgDomain;
+			WindowManager *m_windowManager;
+			Windows::StyleSheetReloader *m_styleSheetReloader;
+			QString m_orgName;
+			QString m_appName;
+			QStringList m_arguments;
+			bool m_isSecondary;
+		};
+	}
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __PRODUCTMODULE__H_
+#define __PRODUCTMODULE__H_
+
+#include <QtCore/qglobal.h>
+
+class QWidget;
+
+/**
+* \brief Entry point of a product module, a shared library named
+* Studio.Softer.<Product> (ie: Studio.Softer.Designer.dll) which exports:
+*
+*     extern "C" Q_DECL_EXPORT QWidget *createProductContent(QWidget *parent);
+*
+* The module is loaded only when its product type is selected.
+*/
+typedef QWidget *(*CreateProductContent)(QWidget *parent);
+
+#define STUDIOSOFTER_PRODUCT_ENTRY "createProductContent"
+
+#endif
\ No newline at end of file
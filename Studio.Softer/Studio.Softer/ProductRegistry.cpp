@@ -0,0 +1,110 @@
+#include "ProductRegistry.h"
+
+#include <QCoreApplication>
+#include <QLibrary>
+
+
+/**
+* \brief Allows to get the process wide product registry.
+* \return The product registry.
+*/
+Studio::Softer::ProductRegistry& Studio::Softer::ProductRegistry::instance()
+{
+	static ProductRegistry registry;
+	return registry;
+}
+
+
+Studio::Softer::ProductRegistry::ProductRegistry()
+{
+	//Every product is a module, ie: Studio.Softer.Designer, none is compiled in the application.
+}
+
+
+Studio::Softer::ProductRegistry::~ProductRegistry()
+{
+	//The modules stay loaded until the end of the process, their widgets may still be alive.
+	qDeleteAll(m_modules);
+}
+
+
+/**
+* \brief Allows to register a product content compiled in the application.
+* \param product The product type.
+* \param factory The function that creates the content of the main window.
+*/
+void Studio::Softer::ProductRegistry::registerBuiltin(ProductType product, const ContentFactory& factory)
+{
+	m_builtins.insert(product, factory);
+}
+
+
+/**
+* \brief Allows to get the content factory of a product, its module is loaded on the first call.
+* \param product The product type.
+* \return The content factory, empty if the product is not available.
+*/
+Studio::Softer::ProductRegistry::ContentFactory Studio::Softer::ProductRegistry::contentFactory(ProductType product)
+{
+	//No product, no module to look for.
+	if (product == None)
+		return ContentFactory();
+
+	//A module that failed to load is not looked for again, its product uses the built-in content.
+	auto module = m_modules.value(product);
+	if (!module && !m_missingModules.contains(product))
+	{
+		module = new QLibrary(QCoreApplication::applicationDirPath() + QLatin1Char('/') + libraryName(product));
+		if (module->load() && module->resolve(STUDIOSOFTER_PRODUCT_ENTRY))
+		{
+			m_modules.insert(product, module);
+		}
+		else
+		{
+			delete module;
+			module = Q_NULLPTR;
+			m_missingModules.insert(product);
+		}
+	}
+
+	if (module)
+	{
+		auto create = reinterpret_cast<CreateProductContent>(module->resolve(STUDIOSOFTER_PRODUCT_ENTRY));
+		return [create](QWidget *parent) { return create(parent); };
+	}
+
+	return m_builtins.value(product);
+}
+
+
+/**
+* \brief Allows to get the name of a product.
+* \param product The product type.
+* \return The name of the product, ie: Designer.
+*/
+QString Studio::Softer::ProductRegistry::productName(ProductType product)
+{
+	switch (product)
+	{
+	case Audio: return "Audio";
+	case Coder: return "Coder";
+	case Numar: return "Numar";
+	case Photo: return "Photo";
+	case Unreal: return "Unreal";
+	case Wiggle: return "Wiggle";
+	case Visual: return "Visual";
+	case Designer: return "Designer";
+	default: return QString();
+	}
+}
+
+
+/**
+* \brief Allows to get the file name of a product module, without its suffix.
+* \param product The product type.
+* \return The library name, ie: Studio.Softer.Designer.
+*/
+QString Studio::Softer::ProductRegistry::libraryName(ProductType product)
+{
+	return "Studio.Softer." + productName(product);
+}
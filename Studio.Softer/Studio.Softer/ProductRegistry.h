@@ -0,0 +1,48 @@
+#ifndef __PRODUCTREGISTRY__H_
+#define __PRODUCTREGISTRY__H_
+
+#include "studiosofter_global.h"
+#include "ProductModule.h"
+#include "ProductType.h"
+
+#include <QString>
+#include <QHash>
+#include <QSet>
+
+#include <functional>
+
+class QLibrary;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		/**
+		* \brief Creates the content of the main window for a product type.
+		* The product module is loaded on demand, the modules of the other
+		* products are never mapped in the process.
+		*/
+		class STUDIOSOFTER_EXPORT ProductRegistry
+		{
+		public:
+			typedef std::function<QWidget *(QWidget *parent)> ContentFactory;
+
+			static ProductRegistry &instance();
+			void registerBuiltin(ProductType product, const ContentFactory &factory);
+			ContentFactory contentFactory(ProductType product);
+			static QString productName(ProductType product);
+			static QString libraryName(ProductType product);
+
+		private:
+			ProductRegistry();
+			~ProductRegistry();
+			Q_DISABLE_COPY(ProductRegistry)
+
+			QHash<int, ContentFactory> m_builtins;
+			QHash<int, QLibrary *> m_modules;
+			QSet<int> m_missingModules;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
@@ -1,17 +1,17 @@
-#ifndef __PRODUCTTYPE__H_
-#define __PRODUCTTYPE__H_
-
-enum ProductType
-{
-	None,
-	Audio,
-	Coder,
-	Numar,
-	Photo,
-	Unreal,
-	Wiggle,
-	Visual,
-	Designer,
-};
-
+#ifndef __PRODUCTTYPE__H_
+#define __PRODUCTTYPE__H_
+
+enum ProductType
+{
+	None,
+	Audio,
+	Coder,
+	Numar,
+	Photo,
+	Unreal,
+	Wiggle,
+	Visual,
+	Designer,
+};
+
 #endif
\ No newline at end of file
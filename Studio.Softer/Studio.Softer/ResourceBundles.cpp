@@ -0,0 +1,95 @@
+#include "ResourceBundles.h"
+
+#include <QCoreApplication>
+#include <QResource>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+
+
+/**
+* \brief Allows to get the process wide resource bundles.
+* \return The resource bundles.
+*/
+Studio::Softer::ResourceBundles& Studio::Softer::ResourceBundles::instance()
+{
+	static ResourceBundles bundles;
+	return bundles;
+}
+
+
+Studio::Softer::ResourceBundles::ResourceBundles()
+{
+}
+
+
+Studio::Softer::ResourceBundles::~ResourceBundles()
+{
+	for (const auto &bundle : m_bundles)
+	{
+		if (bundle.data) QResource::unregisterResource(bundle.data);
+		delete bundle.file;
+	}
+}
+
+
+/**
+* \brief Allows to declare an external bundle, nothing is loaded until it is needed.
+* \param name The name of the bundle, the file is resources/<name>.rcc.
+* \param prefixes The resource paths the bundle provides, ie: ":/SplashScreen".
+*/
+void Studio::Softer::ResourceBundles::addBundle(const QString& name, const QStringList& prefixes)
+{
+	m_bundles.append({ name, prefixes, false, Q_NULLPTR, Q_NULLPTR });
+}
+
+
+/**
+* \brief Allows to get a resource path, registering the bundle that provides it on demand.
+* \param path The resource path, ie: ":/Icons/DesignerStudio.ico".
+* \param fallback The path returned when the resource does not exist.
+* \return The path when the resource exists, the fallback otherwise.
+*/
+QString Studio::Softer::ResourceBundles::resolve(const QString& path, const QString& fallback)
+{
+	if (path.isEmpty())
+		return fallback;
+
+	for (auto &bundle : m_bundles)
+	{
+		if (bundle.registered) continue;
+
+		for (const auto &prefix : bundle.prefixes)
+		{
+			if (!path.startsWith(prefix)) continue;
+
+			//The file is mapped in memory, the resources are read from the mapping on access.
+			//Qt 5 maps a .rcc given by its path only on Unix, it is read whole on Windows.
+			bundle.registered = true;
+			bundle.file = new QFile(bundlePath(bundle.name));
+			if (bundle.file->open(QIODevice::ReadOnly))
+				bundle.data = bundle.file->map(0, bundle.file->size());
+			if (!bundle.data || !QResource::registerResource(bundle.data))
+			{
+				qWarning("Resource bundle %s is missing", qPrintable(bundlePath(bundle.name)));
+				delete bundle.file;
+				bundle.file = Q_NULLPTR;
+				bundle.data = Q_NULLPTR;
+			}
+			break;
+		}
+	}
+
+	return QFileInfo::exists(path) ? path : fallback;
+}
+
+
+/**
+* \brief Allows to get the file of a bundle.
+* \param name The name of the bundle.
+* \return The path of the .rcc file, next to the executable.
+*/
+QString Studio::Softer::ResourceBundles::bundlePath(const QString& name)
+{
+	return QCoreApplication::applicationDirPath() + QLatin1String("/resources/") + name + QLatin1String(".rcc");
+}
@@ -0,0 +1,47 @@
+#ifndef __RESOURCEBUNDLES__H_
+#define __RESOURCEBUNDLES__H_
+
+#include "studiosofter_global.h"
+
+#include <QStringList>
+#include <QVector>
+
+class QFile;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		/**
+		* \brief Resources shipped as external .rcc files next to the executable,
+		* in resources/<name>.rcc, instead of being compiled in the binary.
+		* A bundle is registered (memory mapped) the first time one of its paths is resolved.
+		*/
+		class STUDIOSOFTER_EXPORT ResourceBundles
+		{
+		public:
+			static ResourceBundles &instance();
+			void addBundle(const QString &name, const QStringList &prefixes);
+			QString resolve(const QString &path, const QString &fallback = QString());
+			static QString bundlePath(const QString &name);
+
+		private:
+			ResourceBundles();
+			~ResourceBundles();
+			Q_DISABLE_COPY(ResourceBundles)
+
+			struct Bundle
+			{
+				QString name;
+				QStringList prefixes;
+				bool registered;
+				QFile *file;
+				uchar *data;
+			};
+
+			QVector<Bundle> m_bundles;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
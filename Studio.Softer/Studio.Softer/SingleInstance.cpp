@@ -0,0 +1,158 @@
+#include "SingleInstance.h"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDataStream>
+#include <QDir>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#endif
+
+namespace {
+	const char acknowledge = 0x06;
+
+	auto user_name() -> QString {
+		auto name = qgetenv("USERNAME");
+		if (name.isEmpty()) name = qgetenv("USER");
+		return QString::fromLocal8Bit(name);
+	}
+}
+
+
+/**
+* \brief Allows to initialize the single instance guard of an application.
+* \param key The unique key of the application.
+*/
+Studio::Softer::SingleInstance::SingleInstance(const QString& key) :
+	m_server(Q_NULLPTR), m_mutex(Q_NULLPTR)
+{
+	//One server per user, so that two sessions on the same machine do not collide.
+	m_serverName = key + QLatin1Char('-') + user_name();
+}
+
+
+Studio::Softer::SingleInstance::~SingleInstance()
+{
+	delete m_server;
+#ifdef Q_OS_WIN
+	if (m_mutex) CloseHandle(m_mutex);
+#endif
+}
+
+
+/**
+* \brief Allows to send the arguments to the running instance, if any.
+* It can be called before the QApplication is constructed.
+* \param arguments The command line arguments of this process.
+* \param timeout The time to wait for the running instance, in milliseconds.
+* \return True when the running instance acknowledged the arguments.
+*/
+bool Studio::Softer::SingleInstance::forwardToPrimary(const QStringList& arguments, int timeout) const
+{
+	QLocalSocket socket;
+	socket.connectToServer(m_serverName);
+	if (!socket.waitForConnected(timeout))
+		return false;
+
+	QByteArray message;
+	QDataStream stream(&message, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_6);
+	stream << arguments << QDir::currentPath();
+
+	socket.write(message);
+	if (!socket.waitForBytesWritten(timeout) || !socket.waitForReadyRead(timeout))
+		return false;
+
+	return socket.read(1) == QByteArray(1, acknowledge);
+}
+
+
+/**
+* \brief Allows to become the running instance.
+* The server left by a crashed instance is removed.
+* \return False if another instance is already running, or if the server cannot listen.
+*/
+bool Studio::Softer::SingleInstance::listen()
+{
+#ifdef Q_OS_WIN
+	//A named pipe accepts several servers, the mutex is the exclusive part. It is released by the system on a crash.
+	m_mutex = CreateMutexW(Q_NULLPTR, FALSE, reinterpret_cast<const wchar_t *>(("Local\\" + m_serverName).utf16()));
+	if (!m_mutex || GetLastError() == ERROR_ALREADY_EXISTS)
+		return false;
+#endif
+
+	m_server = new QLocalServer;
+	m_server->setSocketOptions(QLocalServer::UserAccessOption);
+
+	if (!m_server->listen(m_serverName))
+	{
+		if (m_server->serverError() != QAbstractSocket::AddressInUseError)
+		{
+			qWarning("Cannot listen to %s: %s", qPrintable(m_serverName), qPrintable(m_server->errorString()));
+			return false;
+		}
+
+		//Another instance may have started in the meantime.
+		QLocalSocket socket;
+		socket.connectToServer(m_serverName);
+		if (socket.waitForConnected(100))
+			return false;
+
+		//Nobody answers, the socket was left by a crashed instance.
+		QLocalServer::removeServer(m_serverName);
+		if (!m_server->listen(m_serverName))
+		{
+			qWarning("Cannot listen to %s: %s", qPrintable(m_serverName), qPrintable(m_server->errorString()));
+			return false;
+		}
+	}
+
+	QObject::connect(m_server, &QLocalServer::newConnection, [this]()
+	{
+		while (auto socket = m_server->nextPendingConnection())
+		{
+			QObject::connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+			QObject::connect(socket, &QLocalSocket::readyRead, socket, [this, socket]() { receive(socket); });
+		}
+	});
+
+	return true;
+}
+
+
+/**
+* \brief Allows to handle the arguments sent by the next launches.
+* The messages received before the handler is set are delivered now.
+* \param handler The function called for each message.
+*/
+void Studio::Softer::SingleInstance::setMessageHandler(const MessageHandler& handler)
+{
+	m_handler = handler;
+
+	for (const auto &message : m_pendingMessages)
+		m_handler(message.first, message.second);
+	m_pendingMessages.clear();
+}
+
+
+void Studio::Softer::SingleInstance::receive(QLocalSocket* socket)
+{
+	QDataStream stream(socket);
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	QStringList arguments;
+	QString workingDirectory;
+	stream.startTransaction();
+	stream >> arguments >> workingDirectory;
+	if (!stream.commitTransaction())
+		return;
+
+	socket->write(&acknowledge, 1);
+	socket->flush();
+
+	if (m_handler)
+		m_handler(arguments, workingDirectory);
+	else
+		m_pendingMessages.append(qMakePair(arguments, workingDirectory));
+}
@@ -0,0 +1,49 @@
+#ifndef __SINGLEINSTANCE__H_
+#define __SINGLEINSTANCE__H_
+
+#include "studiosofter_global.h"
+
+#include <QStringList>
+#include <QVector>
+#include <QPair>
+
+#include <functional>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		/**
+		* \brief Allows only one running instance of an application.
+		* A second launch sends its arguments and working directory to the
+		* running instance through a local socket, then exits.
+		* On Windows the running instance also owns a named mutex, several servers can listen on the same pipe.
+		*/
+		class STUDIOSOFTER_EXPORT SingleInstance
+		{
+		public:
+			typedef std::function<void(const QStringList &arguments, const QString &workingDirectory)> MessageHandler;
+
+			explicit SingleInstance(const QString &key);
+			~SingleInstance();
+			bool forwardToPrimary(const QStringList &arguments, int timeout = 500) const;
+			bool listen();
+			void setMessageHandler(const MessageHandler &handler);
+
+		private:
+			Q_DISABLE_COPY(SingleInstance)
+			void receive(QLocalSocket *socket);
+
+			QVector<QPair<QStringList, QString>> m_pendingMessages;
+			MessageHandler m_handler;
+			QLocalServer *m_server;
+			QString m_serverName;
+			Qt::HANDLE m_mutex;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "StartupTracer.h"
+
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSaveFile>
+
+namespace {
+	const char traceSwitch[] = "--trace-startup=";
+	const char traceVariable[] = "STUDIO_SOFTER_TRACE";
+	const char benchmarkSwitch[] = "--startup-benchmark=";
+	const char benchmarkVariable[] = "STUDIO_SOFTER_BENCHMARK";
+
+	auto save_json(const QString& path, const QJsonObject& root) -> bool {
+		QSaveFile file(path);
+		if (!file.open(QIODevice::WriteOnly))
+			return false;
+		file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+		return file.commit();
+	}
+}
+
+
+/**
+* \brief Allows to get the process wide startup tracer.
+* \return The startup tracer, its clock starts on the first call.
+*/
+Studio::Softer::StartupTracer& Studio::Softer::StartupTracer::instance()
+{
+	static StartupTracer tracer;
+	return tracer;
+}
+
+
+Studio::Softer::StartupTracer::StartupTracer() :
+	m_enabled(false)
+{
+	m_clock.start();
+}
+
+
+/**
+* \brief Allows to enable the tracer from the command line or the environment.
+* \param argc The integer(argc) of the main function.
+* \param argv The *char[] pointer of the main function.
+*/
+void Studio::Softer::StartupTracer::configure(int argc, char *argv[])
+{
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto argument = QString::fromLocal8Bit(argv[i]);
+		if (argument.startsWith(QLatin1String(traceSwitch)))
+			m_outputPath = argument.mid(static_cast<int>(qstrlen(traceSwitch)));
+		else if (argument.startsWith(QLatin1String(benchmarkSwitch)))
+			m_benchmarkPath = argument.mid(static_cast<int>(qstrlen(benchmarkSwitch)));
+	}
+
+	if (m_outputPath.isEmpty())
+		m_outputPath = QString::fromLocal8Bit(qgetenv(traceVariable));
+	if (m_benchmarkPath.isEmpty())
+		m_benchmarkPath = QString::fromLocal8Bit(qgetenv(benchmarkVariable));
+
+	m_enabled = !m_outputPath.isEmpty() || !m_benchmarkPath.isEmpty();
+	if (m_enabled) m_events.reserve(64);
+}
+
+
+/**
+* \brief Allows to know if the startup phases are recorded.
+* \return True when an output file was requested.
+*/
+bool Studio::Softer::StartupTracer::isEnabled() const
+{
+	return m_enabled;
+}
+
+
+/**
+* \brief Allows to know if the application runs as a startup benchmark.
+* \return True when the benchmark results were requested.
+*/
+bool Studio::Softer::StartupTracer::isBenchmark() const
+{
+	return !m_benchmarkPath.isEmpty();
+}
+
+
+/**
+* \brief Allows to describe the conditions of the run, ie: if a window state was restored.
+* \param key The name of the value.
+* \param value The value, written with the benchmark results.
+*/
+void Studio::Softer::StartupTracer::setMetadata(const QString& key, const QVariant& value)
+{
+	if (!m_enabled) return;
+	m_metadata.insert(key, value);
+}
+
+
+/**
+* \brief Allows to open a startup phase.
+* \param phase The name of the phase.
+*/
+void Studio::Softer::StartupTracer::begin(const QString& phase)
+{
+	if (!m_enabled) return;
+	m_events.append({ phase, 'B', m_clock.nsecsElapsed() });
+}
+
+
+/**
+* \brief Allows to close a startup phase.
+* \param phase The name of the phase.
+*/
+void Studio::Softer::StartupTracer::end(const QString& phase)
+{
+	if (!m_enabled) return;
+	m_events.append({ phase, 'E', m_clock.nsecsElapsed() });
+}
+
+
+/**
+* \brief Allows to record an instant event.
+* \param name The name of the event.
+*/
+void Studio::Softer::StartupTracer::mark(const QString& name)
+{
+	if (!m_enabled) return;
+	m_events.append({ name, 'i', m_clock.nsecsElapsed() });
+}
+
+
+/**
+* \brief Allows to get the time since the tracer was created.
+* \return The elapsed time in nanoseconds.
+*/
+qint64 Studio::Softer::StartupTracer::elapsed() const
+{
+	return m_clock.nsecsElapsed();
+}
+
+
+/**
+* \brief Allows to write the recorded phases in the Chrome trace format.
+* \return True when the trace file was written.
+*/
+bool Studio::Softer::StartupTracer::write()
+{
+	if (m_outputPath.isEmpty()) return false;
+
+	QJsonArray traceEvents;
+	const auto pid = QCoreApplication::applicationPid();
+	for (const auto &event : m_events)
+	{
+		QJsonObject object;
+		object.insert("name", event.name);
+		object.insert("cat", QStringLiteral("startup"));
+		object.insert("ph", QString(QLatin1Char(event.type)));
+		object.insert("ts", static_cast<double>(event.timestamp) / 1000.0);
+		object.insert("pid", pid);
+		object.insert("tid", 1);
+		if (event.type == 'i') object.insert("s", QStringLiteral("g"));
+		traceEvents.append(object);
+	}
+
+	QJsonObject root;
+	root.insert("traceEvents", traceEvents);
+	root.insert("displayTimeUnit", QStringLiteral("ms"));
+	root.insert("metadata", QJsonObject::fromVariantMap(m_metadata));
+	return save_json(m_outputPath, root);
+}
+
+
+/**
+* \brief Allows to write the duration of each phase and the time of each event, in milliseconds.
+* \return True when the benchmark file was written.
+*/
+bool Studio::Softer::StartupTracer::writeBenchmark()
+{
+	if (m_benchmarkPath.isEmpty()) return false;
+
+	QJsonObject phases;
+	QJsonObject events;
+	QVector<const Event *> opened;
+	for (const auto &event : m_events)
+	{
+		if (event.type == 'B')
+		{
+			opened.append(&event);
+		}
+		else if (event.type == 'E')
+		{
+			for (auto i = opened.size() - 1; i >= 0; --i)
+			{
+				if (opened[i]->name != event.name) continue;
+				phases.insert(event.name, static_cast<double>(event.timestamp - opened[i]->timestamp) / 1e6);
+				opened.remove(i);
+				break;
+			}
+		}
+		else
+		{
+			events.insert(event.name, static_cast<double>(event.timestamp) / 1e6);
+		}
+	}
+
+	QJsonObject root;
+	root.insert("phases", phases);
+	root.insert("events", events);
+	root.insert("metadata", QJsonObject::fromVariantMap(m_metadata));
+	return save_json(m_benchmarkPath, root);
+}
+
+
+/**
+* \brief Allows to trace a phase until the end of the current scope.
+* \param phase The name of the phase.
+*/
+Studio::Softer::StartupPhase::StartupPhase(const QString& phase) :
+	m_phase(phase)
+{
+	StartupTracer::instance().begin(m_phase);
+}
+
+
+Studio::Softer::StartupPhase::~StartupPhase()
+{
+	StartupTracer::instance().end(m_phase);
+}
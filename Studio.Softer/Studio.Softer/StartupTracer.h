@@ -0,0 +1,76 @@
+#ifndef __STARTUPTRACER__H_
+#define __STARTUPTRACER__H_
+
+#include "studiosofter_global.h"
+
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <QString>
+#include <QVector>
+
+namespace Studio
+{
+	namespace Softer
+	{
+		/**
+		* \brief Records the startup phases of an application on a monotonic clock
+		* and writes them as a Chrome trace (chrome://tracing, Perfetto) file.
+		*
+		* Tracing is enabled with the --trace-startup=<file> command line switch
+		* or the STUDIO_SOFTER_TRACE=<file> environment variable.
+		*
+		* The --startup-benchmark=<file> switch (STUDIO_SOFTER_BENCHMARK=<file>) writes
+		* the duration of each phase as JSON and quits once the content of the window exists,
+		* to track startup regressions between releases, ie: under QT_QPA_PLATFORM=offscreen.
+		* With --benchmark-windows=<count>, the application opens that many windows first.
+		*/
+		class STUDIOSOFTER_EXPORT StartupTracer
+		{
+		public:
+			static StartupTracer &instance();
+			void configure(int argc, char *argv[]);
+			bool isEnabled() const;
+			bool isBenchmark() const;
+			void begin(const QString &phase);
+			void end(const QString &phase);
+			void mark(const QString &name);
+			void setMetadata(const QString &key, const QVariant &value);
+			qint64 elapsed() const;
+			bool write();
+			bool writeBenchmark();
+
+		private:
+			StartupTracer();
+
+			struct Event
+			{
+				QString name;
+				char type;
+				qint64 timestamp;
+			};
+
+			QElapsedTimer m_clock;
+			QVector<Event> m_events;
+			QVariantMap m_metadata;
+			QString m_outputPath;
+			QString m_benchmarkPath;
+			bool m_enabled;
+		};
+
+		/**
+		* \brief Traces a startup phase for the lifetime of the scope.
+		*/
+		class STUDIOSOFTER_EXPORT StartupPhase
+		{
+		public:
+			explicit StartupPhase(const QString &phase);
+			~StartupPhase();
+
+		private:
+			Q_DISABLE_COPY(StartupPhase)
+			QString m_phase;
+		};
+	}
+}
+
+#endif
\ No newline at end of file
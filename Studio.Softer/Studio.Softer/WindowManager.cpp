@@ -0,0 +1,184 @@
+#include "WindowManager.h"
+#include "Window.h"
+
+#include <QApplication>
+#include <QMenuBar>
+#include <QMenu>
+
+
+Studio::Softer::WindowManager::WindowManager() :
+	m_stateAnimation(false)
+{
+}
+
+
+Studio::Softer::WindowManager::~WindowManager()
+{
+	//The windows use the shared menus, they are closed first.
+	auto windows = m_windows;
+	m_windows.clear();
+	qDeleteAll(windows);
+	qDeleteAll(m_menus);
+}
+
+
+/**
+* \brief Allows to set the function that creates the content of each window.
+* \param factory The content factory, ie: the one of the product, see ProductRegistry.
+*/
+void Studio::Softer::WindowManager::setContentFactory(const ContentFactory& factory)
+{
+	m_contentFactory = factory;
+}
+
+
+/**
+* \brief Allows to set the names used for the title and the persisted state of the windows.
+* \param orgName The organization name.
+* \param appName The application name.
+*/
+void Studio::Softer::WindowManager::setApplicationInfo(const QString& orgName, const QString& appName)
+{
+	m_orgName = orgName;
+	m_appName = appName;
+}
+
+
+/**
+* \brief Allows to set the theme of the windows, the stylesheet itself is applied to the whole application.
+* \param themeHash The hash of the theme, see Windows::StyleSheet::hash.
+*/
+void Studio::Softer::WindowManager::setThemeHash(const QByteArray& themeHash)
+{
+	m_themeHash = themeHash;
+	for (auto window : m_windows)
+		window->setThemeHash(themeHash);
+}
+
+
+/**
+* \brief Allows to set the icon of the windows, it is decoded once for all of them.
+* \param icon The icon.
+*/
+void Studio::Softer::WindowManager::setIcon(const QIcon& icon)
+{
+	m_icon = icon;
+	for (auto window : m_windows)
+		window->setIcon(icon);
+}
+
+
+/**
+* \brief Allows to animate the minimize, maximize and restore transitions of the windows.
+* \param enabled True to animate them, see Windows::WindowStateAnimator.
+*/
+void Studio::Softer::WindowManager::setStateAnimationEnabled(bool enabled)
+{
+	m_stateAnimation = enabled;
+	for (auto window : m_windows)
+		window->setStateAnimationEnabled(enabled);
+}
+
+
+/**
+* \brief Allows to add a menu to the menu bar of every window.
+* The menu and its actions are shared, only their menu bar entry exists per window.
+* \param title The title of the menu.
+* \return The menu, owned by the window manager.
+*/
+QMenu* Studio::Softer::WindowManager::addMenu(const QString& title)
+{
+	auto menu = new QMenu(title);
+	m_menus.append(menu);
+
+	for (auto window : m_windows)
+	{
+		if (auto menuBar = window->findChild<QMenuBar *>("windowMenuBar"))
+			menuBar->addMenu(menu);
+	}
+	return menu;
+}
+
+
+/**
+* \brief Allows to create a window, it is shown by showWindow.
+* \return The window, deleted when it is closed.
+*/
+Studio::Softer::Windows::Window* Studio::Softer::WindowManager::createWindow()
+{
+	auto menuBar = new QMenuBar;
+	menuBar->setObjectName("windowMenuBar");
+	for (auto menu : m_menus)
+		menuBar->addMenu(menu);
+
+	auto window = new Windows::Window(menuBar, m_contentFactory);
+	window->setAttribute(Qt::WA_DeleteOnClose);
+	window->setOrganizationName(m_orgName);
+	window->setapplicationName(m_appName);
+	window->setWindowTitle(m_appName);
+	window->setThemeHash(m_themeHash);
+	window->setIcon(m_icon);
+	window->setStateAnimationEnabled(m_stateAnimation);
+
+	QObject::connect(window, &QObject::destroyed, [this, window]() { m_windows.removeOne(window); });
+	return window;
+}
+
+
+/**
+* \brief Allows to show a window created by createWindow.
+* The first window takes the persisted state, the next ones cascade from the active window.
+* \param window The window.
+*/
+void Studio::Softer::WindowManager::showWindow(Windows::Window* window)
+{
+	auto previous = activeWindow();
+	m_windows.append(window);
+
+	if (!previous)
+	{
+		window->showWindow();
+		return;
+	}
+
+	//One title bar lower than the active window.
+	window->setGeometry(previous->normalGeometry().translated(30, 30));
+	window->setWindowState(previous->windowState() & Qt::WindowMaximized);
+	window->show();
+}
+
+
+/**
+* \brief Allows to create and show a window.
+* \return The window, deleted when it is closed.
+*/
+Studio::Softer::Windows::Window* Studio::Softer::WindowManager::openWindow()
+{
+	auto window = createWindow();
+	showWindow(window);
+	return window;
+}
+
+
+/**
+* \brief Allows to get the window with the focus, or the last one opened.
+* \return The window, null when no window is open.
+*/
+Studio::Softer::Windows::Window* Studio::Softer::WindowManager::activeWindow() const
+{
+	auto active = qobject_cast<Windows::Window *>(QApplication::activeWindow());
+	if (active && m_windows.contains(active))
+		return active;
+
+	return m_windows.isEmpty() ? Q_NULLPTR : m_windows.last();
+}
+
+
+/**
+* \brief Allows to get the open windows.
+* \return The windows, in the order they were opened.
+*/
+const QList<Studio::Softer::Windows::Window *>& Studio::Softer::WindowManager::windows() const
+{
+	return m_windows;
+}
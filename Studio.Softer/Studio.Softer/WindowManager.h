@@ -0,0 +1,63 @@
+#ifndef __WINDOWMANAGER__H_
+#define __WINDOWMANAGER__H_
+
+#include "studiosofter_global.h"
+#include "ContentHost.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QList>
+#include <QIcon>
+
+class QMenu;
+
+namespace Studio
+{
+	namespace Softer
+	{
+		namespace Windows
+		{
+			class Window;
+		}
+
+		/**
+		* \brief Opens the windows of the application, one per document.
+		* The windows share the theme, the icon and the menus with their actions, only
+		* the menu bar and the window itself are created for each of them. The content
+		* of a window is created after its first frame, see Windows::ContentHost.
+		*/
+		class STUDIOSOFTER_EXPORT WindowManager
+		{
+		public:
+			typedef Windows::ContentHost::ContentFactory ContentFactory;
+
+			WindowManager();
+			~WindowManager();
+			void setContentFactory(const ContentFactory &factory);
+			void setApplicationInfo(const QString &orgName, const QString &appName);
+			void setThemeHash(const QByteArray &themeHash);
+			void setIcon(const QIcon &icon);
+			void setStateAnimationEnabled(bool enabled);
+			QMenu *addMenu(const QString &title);
+			Windows::Window *createWindow();
+			void showWindow(Windows::Window *window);
+			Windows::Window *openWindow();
+			Windows::Window *activeWindow() const;
+			const QList<Windows::Window *> &windows() const;
+
+		private:
+			Q_DISABLE_COPY(WindowManager)
+
+			ContentFactory m_contentFactory;
+			QList<Windows::Window *> m_windows;
+			QList<QMenu *> m_menus;
+			QByteArray m_themeHash;
+			QString m_orgName;
+			QString m_appName;
+			QIcon m_icon;
+			bool m_stateAnimation;
+		};
+	}
+}
+
+#endif
\ No newline at end of file